@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ 
+ 
+ LICENSE:
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+
+/* Auto wah from Faust/AutoWah.dsp, native version by the OWL team */
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __AutoCrybabyWahPatch_hpp__
+#define __AutoCrybabyWahPatch_hpp__
+
+#include "StompBox.h"
+#include "WahEngine.hpp"
+
+#define AUTOWAH_LFO_HZ 0.25f // triangle rate, one sweep down and up every 8 seconds
+
+/*
+  Native version of Faust/AutoWah.dsp: the pedal position moves between
+  Low (A) and High (B) following a triangle LFO. The LFO is a phase
+  accumulator wrapped by subtraction over [0, 2) in place of fmodf.
+*/
+class AutoCrybabyWahPatch : public Patch {
+private:
+  WahEngine wah;
+  AudioBuffer* position;
+  float phase;
+  float increment;
+public:
+  AutoCrybabyWahPatch() : phase(0) {
+    registerParameter(PARAMETER_A, "Low");
+    registerParameter(PARAMETER_B, "High");
+    wah.setSampleRate(getSampleRate());
+    position = createMemoryBuffer(1, getBlockSize());
+    increment = AUTOWAH_LFO_HZ/getSampleRate();
+  }
+  void processAudio(AudioBuffer &buffer){
+    int size = buffer.getSize();
+    float lo = getParameterValue(PARAMETER_A);
+    float hi = getParameterValue(PARAMETER_B);
+    float* pos = position->getSamples(0);
+    float ph = phase;
+    for(int i=0; i<size; ++i){
+      ph += increment;
+      if(ph >= 2.0f)
+	ph -= 2.0f;
+      float tri = fabsf(ph - 1.0f);
+      pos[i] = hi + (lo - hi)*tri;
+    }
+    phase = ph;
+    float* samples = buffer.getSamples(0);
+    wah.process(&samples, 1, pos, size);
+  }
+};
+
+#endif // __AutoCrybabyWahPatch_hpp__
@@ -278,6 +278,106 @@ void
 
 
 
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+#define AT_FRAG_PAD 4 // wrapped samples either side of the unwrapped fragment
+#define AT_LANES 4 // grain samples interpolated side by side
+
+// 4-point cubic interpolation of frag at position indd, which may be negative;
+// frag must be readable from (int)indd-1 to (int)indd+2
+static inline float cubicInterpolate(const float* frag, float indd)
+{
+    int ind1 = (int)indd;
+    float d = indd - ind1;
+    float dp1 = d + 1;
+    float dm1 = d - 1;
+    float dm2 = d - 2;
+    const float* val = frag + ind1;
+    float vald = 0;
+    vald = vald - (float)0.166666666667 * val[-1] * d * dm1 * dm2;
+    vald = vald + (float)0.5 * val[0] * dp1 * dm1 * dm2;
+    vald = vald - (float)0.5 * val[1] * dp1 * d * dm2;
+    vald = vald + (float)0.166666666667 * val[2] * dp1 * d * dm1;
+    return vald;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ Analysis and resynthesis windows for one circular buffer size, together with
+ the inverse autocorrelation of the analysis window used to unbias the pitch
+ confidence. They only depend on the buffer size (2048 or 4096, picked from the
+ sample rate), so they are built on first use and then shared read-only by every
+ Autotalent instance, which keeps the FFT work out of init() and Reset().
+ The tables stay allocated for the lifetime of the program.
+*/
+struct AutotalentWindows
+{
+    unsigned long size;
+    float* hann; // length-N hann
+    float* cbwindow; // hann of length N/2, zeros for the rest
+    float* acwinv; // inverse of autocorrelation of cbwindow
+    
+    static const AutotalentWindows* get(unsigned long N) {
+        static AutotalentWindows cache[2]; // one slot per buffer size
+        AutotalentWindows* windows = &cache[N > 2048 ? 1 : 0];
+        if (windows->size != N) {
+            windows->build(N);
+        }
+        return windows;
+    }
+    
+private:
+    void build(unsigned long N) {
+        unsigned long ti;
+        unsigned long Nf = N / 2 + 1;
+        
+        free(hann);
+        free(cbwindow);
+        free(acwinv);
+        
+        // Standard raised cosine window, max height at N/2
+        hann = (float*) calloc(N, sizeof(float));
+        for (ti=0; ti<N; ti++) {
+            hann[ti] = -0.5*cos(2*PI*ti/N) + 0.5;
+        }
+        
+        // Generate a window with a single raised cosine from N/4 to 3N/4
+        cbwindow = (float*) calloc(N, sizeof(float));
+        for (ti=0; ti<(N / 2); ti++) {
+            cbwindow[ti+N/4] = -0.5*cos(4*PI*ti/(N - 1)) + 0.5;
+        }
+        
+        // ---- Calculate autocorrelation of window ----
+        fft_vars* fft = fft_con(N);
+        float* fftfreqre = (float*) calloc(Nf, sizeof(float));
+        float* fftfreqim = (float*) calloc(Nf, sizeof(float));
+        acwinv = (float*) calloc(N, sizeof(float));
+        fft_forward(fft, cbwindow, fftfreqre, fftfreqim);
+        for (ti=0; ti<Nf; ti++) {
+            fftfreqre[ti] = (fftfreqre[ti])*(fftfreqre[ti]) + (fftfreqim[ti])*(fftfreqim[ti]);
+            fftfreqim[ti] = 0;
+        }
+        fft_inverse(fft, fftfreqre, fftfreqim, acwinv);
+        for (ti=1; ti<N; ti++) {
+            acwinv[ti] = acwinv[ti]/acwinv[0];
+            if (acwinv[ti] > 0.000001) {
+                acwinv[ti] = (float)1/acwinv[ti];
+            }
+            else {
+                acwinv[ti] = 0;
+            }
+        }
+        acwinv[0] = 1;
+        free(fftfreqre);
+        free(fftfreqim);
+        fft_des(fft);
+        // ---- END Calculate autocorrelation of window ----
+        
+        size = N;
+    }
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 class Autotalent
@@ -290,10 +390,9 @@ public:
     	free(mcbi);
     	free(mcbf);
     	free(mcbo);
-    	free(mcbwindow);
-    	free(mhannwindow);
-    	free(macwinv);
     	free(mfrag);
+    	free(mgrain);
+    	free(mgrainwin);
     	free(mffttime);
     	free(mfftfreqre);
     	free(mfftfreqim);
@@ -318,6 +417,7 @@ public:
     void init (unsigned long SampleRate, unsigned long mBufSize);
     void Reset(unsigned long SampleRate, unsigned long mBufSize);
     void processReplacing(float *inputBuffer, float *outputBuffer, int SampleCount);
+    void resynthesise(long int grainsize);
 
     fft_vars* mfmembvars; // member variables for fft routine
     
@@ -355,9 +455,9 @@ private:
     float* mcbf; // circular formant correction buffer
     float* mcbo; // circular output buffer
     
-    float* mcbwindow; // hann of length N/2, zeros for the rest
-    float* macwinv; // inverse of autocorrelation of window
-    float* mhannwindow; // length-N hann
+    const float* mcbwindow; // hann of length N/2, zeros for the rest
+    const float* macwinv; // inverse of autocorrelation of window
+    const float* mhannwindow; // length-N hann
     int mnoverlap;
     
     float* mffttime;
@@ -389,8 +489,10 @@ private:
     double mphincfact; // factor determining output phase increment
     double mphasein;
     double mphaseout;
-    float* mfrag; // windowed fragment of speech
+    float* mfrag; // windowed fragment of speech, unwrapped with AT_FRAG_PAD wrapped samples either side
     unsigned long mfragsize; // size of fragment in samples
+    float* mgrain; // resynthesised grain, N/2
+    float* mgrainwin; // crossfade of the grain, N/2
     
     // VARIABLES FOR FORMANT CORRECTOR
     int mford;
@@ -447,8 +549,6 @@ Autotalent::Autotalent(unsigned long SampleRate) {
 
 void Autotalent::init(unsigned long SampleRate, unsigned long mBufSize)
 {
-    unsigned long ti;
-    
     //Autotalent* membvars = malloc(sizeof(Autotalent));
     
     //AudioBuffer* mBuf = createMemoryBuffer(mBufSize, sizeof(float));
@@ -506,17 +606,11 @@ void Autotalent::init(unsigned long SampleRate, unsigned long mBufSize)
 //    mfmutealph = pow(0.001f, (float)1 / (SampleRate));
     
     
-    // Standard raised cosine window, max height at N/2
-    mhannwindow = (float*) calloc(mcbsize, sizeof(float));
-    for (ti=0; ti<mcbsize; ti++) {
-        mhannwindow[ti] = -0.5*cos(2*PI*ti/mcbsize) + 0.5;
-    }
-    
-    // Generate a window with a single raised cosine from N/4 to 3N/4
-    mcbwindow = (float*) calloc(mcbsize, sizeof(float));
-    for (ti=0; ti<(mcbsize / 2); ti++) {
-        mcbwindow[ti+mcbsize/4] = -0.5*cos(4*PI*ti/(mcbsize - 1)) + 0.5;
-    }
+    // Windows only depend on the buffer size, they are shared by all instances
+    const AutotalentWindows* windows = AutotalentWindows::get(mcbsize);
+    mhannwindow = windows->hann;
+    mcbwindow = windows->cbwindow;
+    macwinv = windows->acwinv;
     
     mnoverlap = 4;
     
@@ -527,30 +621,6 @@ void Autotalent::init(unsigned long SampleRate, unsigned long mBufSize)
     mfftfreqim = (float*) calloc(mcorrsize, sizeof(float));
     
     
-    // ---- Calculate autocorrelation of window ----
-    macwinv = (float*) calloc(mcbsize, sizeof(float));
-    for (ti=0; ti<mcbsize; ti++) {
-        mffttime[ti] = mcbwindow[ti];
-    }
-    fft_forward(mfmembvars, mcbwindow, mfftfreqre, mfftfreqim);
-    for (ti=0; ti<mcorrsize; ti++) {
-        mfftfreqre[ti] = (mfftfreqre[ti])*(mfftfreqre[ti]) + (mfftfreqim[ti])*(mfftfreqim[ti]);
-        mfftfreqim[ti] = 0;
-    }
-    fft_inverse(mfmembvars, mfftfreqre, mfftfreqim, mffttime);
-    for (ti=1; ti<mcbsize; ti++) {
-        macwinv[ti] = mffttime[ti]/mffttime[0];
-        if (macwinv[ti] > 0.000001) {
-            macwinv[ti] = (float)1/macwinv[ti];
-        }
-        else {
-            macwinv[ti] = 0;
-        }
-    }
-    macwinv[0] = 1;
-    // ---- END Calculate autocorrelation of window ----
-    
-    
     mlrshift = 0;
     mptarget = 0;
     msptarget = 0;
@@ -562,8 +632,10 @@ void Autotalent::init(unsigned long SampleRate, unsigned long mBufSize)
     mphincfact = 1;
     mphasein = 0;
     mphaseout = 0;
-    mfrag = (float*) calloc(mcbsize, sizeof(float));
+    mfrag = (float*) calloc(mcbsize + 2*AT_FRAG_PAD, sizeof(float));
     mfragsize = 0;
+    mgrain = (float*) calloc(mcbsize / 2, sizeof(float));
+    mgrainwin = (float*) calloc(mcbsize / 2, sizeof(float));
     
     //	SetLatency(mcbsize-1);
 }
@@ -613,18 +685,6 @@ void Autotalent::processReplacing(float *inputBuffer, float *outputBuffer, int S
     float tf;
     float tf2;
     
-    // Variables for cubic spline interpolator
-    float indd;
-    int ind0;
-    int ind1;
-    int ind2;
-    int ind3;
-    float vald;
-    float val0;
-    float val1;
-    float val2;
-    float val3;
-    
     int lowersnap;
     int uppersnap;
     
@@ -993,11 +1053,15 @@ void Autotalent::processReplacing(float *inputBuffer, float *outputBuffer, int S
         mphaseout = mphaseout + moutphinc;
         
         //   When input phase resets, take a snippet from N/2 samples in the past
+        //   The whole input ring is copied in order, oldest sample first, so
+        //   that the snippet is centred on mfrag[AT_FRAG_PAD + N/2]
         if (mphasein >= 1) {
             mphasein = mphasein - 1;
-            ti2 = mcbiwr - N/2;
-            for (ti=-N/2; ti<N/2; ti++) {
-                mfrag[(ti+N)%N] = mcbf[(ti + ti2 + N)%N];
+            arm_copy_f32(mcbf + mcbiwr, mfrag + AT_FRAG_PAD, N - mcbiwr);
+            arm_copy_f32(mcbf, mfrag + AT_FRAG_PAD + N - mcbiwr, mcbiwr);
+            for (ti=0; ti<AT_FRAG_PAD; ti++) {
+                mfrag[ti] = mfrag[N + ti];
+                mfrag[AT_FRAG_PAD + N + ti] = mfrag[AT_FRAG_PAD + ti];
             }
         }
         
@@ -1008,30 +1072,11 @@ void Autotalent::processReplacing(float *inputBuffer, float *outputBuffer, int S
                 mfragsize = N;
             }
             mphaseout = mphaseout - 1;
-            ti2 = mcbord + N/2;
             ti3 = (long int)(((float)mfragsize) / mphincfact);
             if (ti3>=N/2) {
                 ti3 = N/2 - 1;
             }
-            for (ti=-ti3/2; ti<(ti3/2); ti++) {
-                tf = mhannwindow[(long int)N/2 + ti*(long int)N/ti3];
-                // 3rd degree polynomial interpolator - based on eqns from Hal Chamberlin's book
-                indd = mphincfact*ti;
-                ind1 = (int)indd;
-                ind2 = ind1+1;
-                ind3 = ind1+2;
-                ind0 = ind1-1;
-                val0 = mfrag[(ind0+N)%N];
-                val1 = mfrag[(ind1+N)%N];
-                val2 = mfrag[(ind2+N)%N];
-                val3 = mfrag[(ind3+N)%N];
-                vald = 0;
-                vald = vald - (float)0.166666666667 * val0 * (indd - ind1) * (indd - ind2) * (indd - ind3);
-                vald = vald + (float)0.5 * val1 * (indd - ind0) * (indd - ind2) * (indd - ind3);
-                vald = vald - (float)0.5 * val2 * (indd - ind0) * (indd - ind1) * (indd - ind3);
-                vald = vald + (float)0.166666666667 * val3 * (indd - ind0) * (indd - ind1) * (indd - ind2);
-                mcbo[(ti + ti2 + N)%N] = mcbo[(ti + ti2 + N)%N] + vald*tf;
-            }
+            resynthesise(ti3);
             mfragsize = 0;
         }
         mfragsize++;
@@ -1140,6 +1185,53 @@ void Autotalent::processReplacing(float *inputBuffer, float *outputBuffer, int S
     }
 }
 
+// Overlap-add one grain of grainsize output samples, centred N/2 samples
+// ahead of the output read pointer, resampling the fragment by mphincfact.
+// The crossfade and the fractional read positions are worked out for the
+// whole grain first, then the interpolation runs AT_LANES samples at a time
+// on the unwrapped fragment and the windowed grain is added to the output
+// ring in at most two contiguous runs.
+void Autotalent::resynthesise(long int grainsize)
+{
+    long int N = mcbsize;
+    long int first = -(grainsize/2);
+    long int count = 2*(grainsize/2);
+    long int ti;
+    int tl;
+    unsigned long start;
+    unsigned long run;
+    float incr = (float)mphincfact;
+    const float* frag = mfrag + AT_FRAG_PAD + N/2;
+    
+    if (count <= 0) {
+        return;
+    }
+    
+    // Crossfade between grains
+    for (ti=0; ti<count; ti++) {
+        mgrainwin[ti] = mhannwindow[N/2 + (first + ti)*N/grainsize];
+    }
+    
+    // 3rd degree polynomial interpolator - based on eqns from Hal Chamberlin's book
+    for (ti=0; ti+AT_LANES<=count; ti+=AT_LANES) {
+        for (tl=0; tl<AT_LANES; tl++) {
+            mgrain[ti+tl] = cubicInterpolate(frag, incr*(first + ti + tl));
+        }
+    }
+    for (; ti<count; ti++) {
+        mgrain[ti] = cubicInterpolate(frag, incr*(first + ti));
+    }
+    
+    arm_mult_f32(mgrain, mgrainwin, mgrain, count);
+    start = (mcbord + N/2 + first + N) % N;
+    run = N - start;
+    if (run > (unsigned long)count) {
+        run = count;
+    }
+    arm_add_f32(mcbo + start, mgrain, mcbo + start, run);
+    arm_add_f32(mcbo, mgrain + run, mcbo, count - run);
+}
+
 /*********************************************************
  * Class TemplatePatch
  *
@@ -31,37 +31,86 @@
 
 #include <string.h> /* for memset */
 
+/**
+ * The buffer is not cleared by initialise(): writes start at index 0 and
+ * filled is the high-water mark of the write head, so samples at or above
+ * it have never been written and read as silence. Once the head has been
+ * all the way round, reads take a fast path that skips the check.
+ */
 class CircularBuffer {
 private:
   float* buffer;
   unsigned int size;
   unsigned int writeIndex;
+  unsigned int filled; // indices [0, filled) have been written
+  inline float get(unsigned int i){
+    if(filled == size)
+      return buffer[i]; // the head has been all the way round
+    return i < filled ? buffer[i] : 0.0f;
+  }
+  /* copy len samples from index start (no wrapping), zero past the high-water mark */
+  void copy(float* values, unsigned int start, unsigned int len){
+    unsigned int valid = start < filled ? filled - start : 0;
+    if(valid > len)
+      valid = len;
+    memcpy(values, buffer+start, valid*sizeof(float));
+    memset(values+valid, 0, (len-valid)*sizeof(float));
+  }
 public:
 //   CircularBuffer(float* buf, int sz) : buffer(buf), size(sz), writeIndex(0) {
-  CircularBuffer() : buffer(NULL), size(0), writeIndex(0) {
+  CircularBuffer() : buffer(NULL), size(0), writeIndex(0), filled(0) {
   }
   void initialise(float* buf, unsigned int sz){
     buffer = buf;
     size = sz;
-    memset(buffer, 0, size*sizeof(float));
+    writeIndex = size-1; // so that the first write goes to index 0
+    filled = 0;
   }
   inline void write(float value){
     if(++writeIndex == size)
       writeIndex = 0;
     buffer[writeIndex] = value;
+    if(filled < size)
+      filled++;
   }  
   inline float read(int index){
-    return buffer[(writeIndex + (~index)) & (size-1)];
+    return get((writeIndex + (~index)) & (size-1));
   }
   inline float head(){
-    return buffer[(writeIndex - 1) & (size-1)];
+    return get((writeIndex - 1) & (size-1));
   }
   inline float tail(){
-    return buffer[(writeIndex) & (size-1)];
+    return get((writeIndex) & (size-1));
   }
   inline unsigned int getSize(){
     return size;
   }
+  /* block equivalent of len successive write() calls */
+  void write(float* values, unsigned int len){
+    unsigned int start = (writeIndex + 1) & (size-1);
+    unsigned int first = size - start;
+    if(first > len)
+      first = len;
+    memcpy(buffer+start, values, first*sizeof(float));
+    memcpy(buffer, values+first, (len-first)*sizeof(float));
+    writeIndex = (writeIndex + len) & (size-1);
+    filled = filled + len < size ? filled + len : size;
+  }
+  /* block equivalent of read(index) interleaved with len write() calls;
+     index must be at least len-1 so that only past samples are read */
+  void read(float* values, unsigned int len, int index){
+    unsigned int start = (writeIndex + (~index)) & (size-1);
+    unsigned int first = size - start;
+    if(first > len)
+      first = len;
+    if(filled == size){
+      memcpy(values, buffer+start, first*sizeof(float));
+      memcpy(values+first, buffer, (len-first)*sizeof(float));
+    }else{
+      copy(values, start, first);
+      copy(values+first, 0, len-first);
+    }
+  }
 };
 
 #endif // __CircularBuffer_h__
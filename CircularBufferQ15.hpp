@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ 
+ 
+ LICENSE:
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+
+/* created by the OWL team 2013 */
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef __CircularBufferQ15_h__
+#define __CircularBufferQ15_h__
+
+#include <string.h> /* for memset */
+
+/**
+ * Circular buffer storing Q15 samples, for long delays at half the memory of a
+ * float buffer. Samples are converted, with saturation, a block at a time using
+ * the CMSIS DSP Library.
+ * The size must be a power of two.
+ */
+class CircularBufferQ15 {
+private:
+  q15_t* buffer;
+  unsigned int size;
+  unsigned int writeIndex;
+  unsigned int filled; // high-water mark: indices [0, filled) have been written
+  /* convert len samples from index start (no wrapping), zero past the high-water mark */
+  void copy(float* values, unsigned int start, unsigned int len){
+    unsigned int valid = start < filled ? filled - start : 0;
+    if(valid > len)
+      valid = len;
+    arm_q15_to_float(buffer+start, values, valid);
+    memset(values+valid, 0, (len-valid)*sizeof(float));
+  }
+public:
+  CircularBufferQ15() : buffer(NULL), size(0), writeIndex(0), filled(0) {
+  }
+  /* the memory is not cleared: unwritten samples read as silence */
+  void initialise(q15_t* buf, unsigned int sz){
+    buffer = buf;
+    size = sz;
+    writeIndex = 0;
+    filled = 0;
+  }
+  /* write a block of samples at the write head */
+  void write(float* values, unsigned int len){
+    unsigned int first = size - writeIndex;
+    if(first > len)
+      first = len;
+    arm_float_to_q15(values, buffer+writeIndex, first);
+    arm_float_to_q15(values+first, buffer, len-first);
+    writeIndex = (writeIndex + len) & (size-1);
+    filled = filled + len < size ? filled + len : size;
+  }
+  /* read a block of samples starting delay samples behind the write head */
+  void read(float* values, unsigned int len, unsigned int delay){
+    unsigned int index = (writeIndex - delay) & (size-1);
+    unsigned int first = size - index;
+    if(first > len)
+      first = len;
+    if(filled == size){
+      arm_q15_to_float(buffer+index, values, first);
+      arm_q15_to_float(buffer, values+first, len-first);
+    }else{
+      copy(values, index, first);
+      copy(values+first, 0, len-first);
+    }
+  }
+  inline unsigned int getSize(){
+    return size;
+  }
+};
+
+#endif // __CircularBufferQ15_h__
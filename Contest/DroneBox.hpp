@@ -126,12 +126,14 @@ private:
   int mDTSamples;
   float mFbkScalar;
   int mWriteAddr;
+  int mWritten; // high-water mark, mBuffer[mWritten..] has not been written yet
   
 public:
   DBCombFilter()
   : mDTSamples(0)
   , mFbkScalar(0.5)
   , mWriteAddr(0)
+  , mWritten(0)
   {
     setFreqCPS(440.);
     setDecayTimeMs(10.);
@@ -142,9 +144,11 @@ public:
       mBuffer = buffer;
   }
     
+    // lazy clear: samples past the high-water mark read as zero until written
     void clearBuffer()
     {
-        memset(mBuffer,0.,BUF_SIZE*sizeof(float));
+        mWriteAddr = 0;
+        mWritten = 0;
     }
   
   void setFreqCPS(float freqCPS)
@@ -167,11 +171,25 @@ public:
     // Linear interpolation
     const int intPart = (int) readAddrF;
     const float fracPart = readAddrF-intPart;
-    const float a = mBuffer[intPart & BUF_MASK];
-    const float b = mBuffer[(intPart+1) & BUF_MASK];
-    float output = a + (b - a) * fracPart;
-    
-    mBuffer[mWriteAddr++] = input + (output * mFbkScalar);
+    const int ia = intPart & BUF_MASK;
+    const int ib = (intPart+1) & BUF_MASK;
+    float output;
+    if (mWritten == (int) BUF_SIZE)
+    {
+      // the whole buffer has been written: no more checks against the mark
+      const float a = mBuffer[ia];
+      output = a + (mBuffer[ib] - a) * fracPart;
+      mBuffer[mWriteAddr++] = input + (output * mFbkScalar);
+    }
+    else
+    {
+      const float a = ia < mWritten ? mBuffer[ia] : 0.;
+      const float b = ib < mWritten ? mBuffer[ib] : 0.;
+      output = a + (b - a) * fracPart;
+      mBuffer[mWriteAddr++] = input + (output * mFbkScalar);
+      if (mWritten < mWriteAddr)
+        mWritten = mWriteAddr;
+    }
     mWriteAddr &= BUF_MASK;
     
     return output;
@@ -11,7 +11,7 @@
 //  - B: amount 1
 //  - C: frequency 2
 //  - D: amount 2
-//  - Push-button:
+//  - Push-button: quadrature stereo (right channel LFOs 90 degrees ahead)
 //
 //  TODO:
 //  - ...
@@ -44,7 +44,9 @@ class DualTremoloPatch : public Patch {
 
   const float MIN_FREQ;
   const float MAX_FREQ;
-  float phase1, phase2;
+  float phase1, phase2; // in cycles, wrapped to [0,1)
+  float* gainL;
+  float* gainR;
 
 public:
   DualTremoloPatch() : MIN_FREQ(0.5), MAX_FREQ(35), phase1(0), phase2(0), ramp(0.1) {
@@ -53,39 +55,75 @@ public:
     registerParameter(PARAMETER_C, "Freq 2");
     registerParameter(PARAMETER_D, "Amount 2");
     memset(oldVal, 0, sizeof(oldVal));
+    AudioBuffer* gains = createMemoryBuffer(2, getBlockSize());
+    gainL = gains->getSamples(0);
+    gainR = gains->getSamples(1);
   }
   void processAudio(AudioBuffer &buffer){
     double rate = getSampleRate();
 
     float p1 = getRampedParameterValue(PARAMETER_A);
     float freq1 = p1*p1 * (MAX_FREQ-MIN_FREQ) + MIN_FREQ;
-    double step1 = freq1 / rate;
+    float step1 = freq1 / rate;
     float amt1 = getRampedParameterValue(PARAMETER_B);
 
     float p2 = getRampedParameterValue(PARAMETER_C);
     float freq2 = p2*p2 * (MAX_FREQ-MIN_FREQ) + MIN_FREQ;
     float amt2 = getRampedParameterValue(PARAMETER_D);
-    double step2 = freq2 / rate;
-    
+    float step2 = freq2 / rate;
+
     int size = buffer.getSize();
+    bool quadrature = isButtonPressed(PUSHBUTTON) && buffer.getChannels() > 1;
 
-  for(int ch = 0; ch<buffer.getChannels(); ++ch)
-  { 
-    float* buf = buffer.getSamples(ch);
+    // Both LFOs are rotating phasors seeded once per block from the wrapped
+    // phase accumulators. The phasor gives sin and cos together, so the
+    // quadrature (stereo offset) LFO only adds the gainR product, and only
+    // in quadrature mode: otherwise gainR is not filled.
+    float s1 = arm_sin_f32(2*M_PI*phase1), c1 = arm_cos_f32(2*M_PI*phase1);
+    float s2 = arm_sin_f32(2*M_PI*phase2), c2 = arm_cos_f32(2*M_PI*phase2);
+    float ds1 = arm_sin_f32(2*M_PI*step1), dc1 = arm_cos_f32(2*M_PI*step1);
+    float ds2 = arm_sin_f32(2*M_PI*step2), dc2 = arm_cos_f32(2*M_PI*step2);
+    float a1 = amt1 / 2, b1 = 1 - a1; // gain = amt * (sin/2 + .5) + (1 - amt)
+    float a2 = amt2 / 2, b2 = 1 - a2;
+    if (quadrature)
+    {
+      for (int i=0; i<size; ++i)
+      {
+        gainL[i] = (a1 * s1 + b1) * (a2 * s2 + b2);
+        gainR[i] = (a1 * c1 + b1) * (a2 * c2 + b2);
+        float t1 = s1 * dc1 + c1 * ds1;
+        c1 = c1 * dc1 - s1 * ds1;
+        s1 = t1;
+        float t2 = s2 * dc2 + c2 * ds2;
+        c2 = c2 * dc2 - s2 * ds2;
+        s2 = t2;
+      }
+    }
+    else
+    {
+      for (int i=0; i<size; ++i)
+      {
+        gainL[i] = (a1 * s1 + b1) * (a2 * s2 + b2);
+        float t1 = s1 * dc1 + c1 * ds1;
+        c1 = c1 * dc1 - s1 * ds1;
+        s1 = t1;
+        float t2 = s2 * dc2 + c2 * ds2;
+        c2 = c2 * dc2 - s2 * ds2;
+        s2 = t2;
+      }
+    }
+    phase1 += step1 * size;
+    phase1 -= floorf(phase1);
+    phase2 += step2 * size;
+    phase2 -= floorf(phase2);
 
-    for (int i=0; i<size; ++i)
+    // all channels see the same LFO position
+    for(int ch = 0; ch<buffer.getChannels(); ++ch)
     {
-      float mod1 = sin(2 * M_PI * phase1) / 2 + .5; // 0..1
-      float mod2 = sin(2 * M_PI * phase2) / 2 + .5; // 0..1
-      float gain1 = (amt1 * mod1) + (1 - amt1);
-      float gain2 = (amt2 * mod2) + (1 - amt2);
-      buf[i] = (gain1 * gain2) * buf[i];
-      phase1 += step1;
-      phase2 += step2;
+      float* buf = buffer.getSamples(ch);
+      arm_mult_f32(buf, (quadrature && ch == 1) ? gainR : gainL, buf, size);
     }
   }
-    
-  }
 
 private:
   // Parameter ramping to reduce clicks.
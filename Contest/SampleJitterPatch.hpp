@@ -41,7 +41,8 @@
 #define OwlSim_SampleJitterPatch_hpp
 
 #include "StompBox.h"
-//#include "juce_Random.h"
+
+#define JITTER_CURVE_SIZE 65 // power curve table points, N+1 for interpolation
 
 class SampleJitterPatch : public Patch {
   
@@ -50,29 +51,39 @@ class SampleJitterPatch : public Patch {
   const float MIN_BIAS; // bias acts as exponent on a random delay time, t = rnd^bias
   const float MAX_BIAS;
   
-  float* circularBuffer;
-  unsigned int bufferSize;
+  AudioBuffer* circularBuffer; // one ring per channel
+  unsigned int bufferMask; // ring size is a power of two
   unsigned int writeIdx;
+  int* offsets; // per-block random delays, shared by all channels
+
+  // xorshift32 PRNG, replaces juce::Random
+  uint32_t seed;
+  float curve[JITTER_CURVE_SIZE]; // maxSampleDelay * x^bias
+  float curveBias;
+  unsigned int curveDelay;
   
 public:
-  SampleJitterPatch() : MIN_DELAY(0.00001), MAX_DELAY(0.02), MIN_BIAS(0.1), MAX_BIAS(6), ramp(0.1) {
+  SampleJitterPatch() : MIN_DELAY(0.00001), MAX_DELAY(0.02), MIN_BIAS(0.1), MAX_BIAS(6),
+			seed(0x9e3779b9), curveBias(-1), curveDelay(0), ramp(0.1) {
     registerParameter(PARAMETER_A, "Rate");
     registerParameter(PARAMETER_B, "Bias");
     registerParameter(PARAMETER_C, "");
     registerParameter(PARAMETER_D, "Dry/Wet");
+    memset(oldVal, 0, sizeof(oldVal));
+    unsigned int bufferSize = 1;
+    while(bufferSize < MAX_DELAY * getSampleRate() + 1)
+      bufferSize <<= 1;
+    bufferMask = bufferSize-1;
+    circularBuffer = createMemoryBuffer(2, bufferSize);
+    circularBuffer->clear();
+    writeIdx = 0;
+    // ints are the size of floats: a one channel float buffer holds a block of offsets
+    offsets = (int*)createMemoryBuffer(1, getBlockSize())->getSamples(0);
   }
  void processAudio(AudioBuffer &buffer) 
   {
 
     double rate = getSampleRate();
-    
-    if (circularBuffer==NULL)
-    {
-      bufferSize = MAX_DELAY * rate;
-      circularBuffer = new float[bufferSize];
-      memset(circularBuffer, 0, bufferSize*sizeof(float));
-      writeIdx = 0;
-    }
 
     float p1 = getRampedParameterValue(PARAMETER_A);
     float p2 = getRampedParameterValue(PARAMETER_B);
@@ -86,33 +97,38 @@ public:
     
     int size = buffer.getSize();
 
-	for(int ch = 0; ch<buffer.getChannels(); ++ch)
-	 { 	
-	    float* buf = buffer.getSamples(ch);
-	    Random r;
-	    for (int i=0; i<size; ++i)
-	    {
-	      int offset = floor(maxSampleDelay * pow(r.nextFloat(), bias) + 0.5);
-	      int readIdx = writeIdx - offset;
-	      while (readIdx<0)
-		readIdx += bufferSize;
+    // only rebuild the power curve when its inputs move
+    if(bias != curveBias || maxSampleDelay != curveDelay)
+      buildCurve(bias, maxSampleDelay);
 
-	      circularBuffer[writeIdx] = buf[i];
-	      buf[i] =
-		circularBuffer[readIdx] * dryWetMix +
-		buf[i] * (1 - dryWetMix);
+    // draw one block of random delays through the interpolated curve
+    for (int i=0; i<size; ++i)
+    {
+      seed ^= seed << 13;
+      seed ^= seed >> 17;
+      seed ^= seed << 5;
+      float pos = (seed >> 8) * ((JITTER_CURVE_SIZE-1) / 16777216.0f);
+      int k = (int)pos;
+      float frac = pos - k;
+      offsets[i] = (int)(curve[k] + frac * (curve[k+1] - curve[k]) + 0.5f);
+    }
 
-	      writeIdx = (++writeIdx) % bufferSize;
-	    }
-	 }
-     
+    int channels = min(buffer.getChannels(), circularBuffer->getChannels());
+    for(int ch = 0; ch<channels; ++ch)
+    {
+      float* buf = buffer.getSamples(ch);
+      float* ring = circularBuffer->getSamples(ch);
+      unsigned int idx = writeIdx;
+      for (int i=0; i<size; ++i)
+      {
+        ring[idx] = buf[i];
+        buf[i] = ring[(idx - offsets[i]) & bufferMask] * dryWetMix + buf[i] * (1 - dryWetMix);
+        idx = (idx + 1) & bufferMask;
+      }
+    }
+    writeIdx = (writeIdx + size) & bufferMask;
   }
   
-  ~SampleJitterPatch(){
-    delete(circularBuffer);
-  }
-
-  
 private:
   // Parameter ramping to reduce clicks.
   
@@ -125,6 +141,13 @@ private:
     oldVal[id] = val;
     return result;
   }
+
+  void buildCurve(float bias, unsigned int maxSampleDelay){
+    for(int k=0; k<JITTER_CURVE_SIZE; ++k)
+      curve[k] = maxSampleDelay * powf((float)k / (JITTER_CURVE_SIZE-1), bias);
+    curveBias = bias;
+    curveDelay = maxSampleDelay;
+  }
 };
 
 #endif // OwlSim_SampleJitterPatch_hpp
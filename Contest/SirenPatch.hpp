@@ -52,6 +52,24 @@ public:
     // using freqHzBuffer, the internal Sawtooth frequency is just ignored
     void processReplacing_tvf(float *outputBuffer, int bufferSize, float *freqHzBuffer);
     
+    // process_tick : advance the sawtooth by one sample
+    inline float process_tick()
+    {
+        this->_val += this->_freq_normalized;
+        if (this->_val >= 1.f)
+            this->_val -= 1.f;
+        return this->_val;
+    }
+    
+    // process_tick with a time varying frequency, given normalized (freqHz/fs)
+    inline float process_tick_tvf(float freq_normalized)
+    {
+        this->_val += fabsf(freq_normalized); // fabs for security (to avoid negative frequencies)
+        if (this->_val >= 1.f)
+            this->_val -= 1.f;
+        return this->_val;
+    }
+    
     void setFreqHz(float f)
     {
         this->_freqHz=fabs(f); // warning: negative frequency would make the sawtooth go crazy (=>fabs for security)
@@ -122,6 +140,15 @@ public:
     // process replacing
     void processReplacing(float *inputBuffer, float *outputBuffer, int bufferSize);
 
+    // process_tick : filter one input sample
+    inline float process_tick(float x)
+    {
+        float y = x - this->_xNmoins1 + 0.9999f * this->_yNmoins1;
+        this->_yNmoins1 = fabsf(y) < MY_FLOAT_THRESHOLD ? 0.f : y;
+        this->_xNmoins1 = x;
+        return this->_yNmoins1;
+    }
+
 private:
     // INTERNAL THINGS
     float _xNmoins1; // x[n-1]
@@ -187,10 +214,6 @@ public:
     {
         this->_mode=mode;
     }
-
-  void setBuffer(AudioBuffer* buffer){
-    freqHzBuffer = buffer->getSamples(0);
-  }    
     
 private:
     // PARAMETERS
@@ -204,7 +227,6 @@ private:
     Sawtooth _sawtooth_fm;
     DCcutFilter _DCcutFilter1;
     DCcutFilter _DCcutFilter2;
-    float* freqHzBuffer;
 };
 
 FMSynth::FMSynth(float f0, float fm, float fs) : _sawtooth_f0(f0,fs,0.5) , _sawtooth_fm(fm,fs)
@@ -216,46 +238,42 @@ FMSynth::FMSynth(float f0, float fm, float fs) : _sawtooth_f0(f0,fs,0.5) , _sawt
 }
 
 void FMSynth::processReplacing(float *outputBuffer, int bufferSize)
-{    
-    // compute modulation frequency (LFO)
-    this->_sawtooth_fm.processReplacing(freqHzBuffer, bufferSize);
-    
-    // REPLACE SAWTOOTH LFO BY A SINUSOIDAL LFO
-    for (int i_samp=0; i_samp<bufferSize; i_samp++)
-    {
-        freqHzBuffer[i_samp] = sinf(2*M_PI*freqHzBuffer[i_samp]) * 0.5;
-    }
-    
-    // filter the sawtooth to remove its DC. Solves the terrible case fm=0 (that produces a random frequency offset).
-    this->_DCcutFilter1.processReplacing(freqHzBuffer, freqHzBuffer, bufferSize);
-    
-    // other modes for computing fm (square-based modulations)
-    if (this->_mode > 0)
-    {
-        for (int i_samp=0; i_samp<bufferSize; ++i_samp)
-        {
-            freqHzBuffer[i_samp] = freqHzBuffer[i_samp]>-0.00001 ? 0.5*this->_mode : -0.5*this->_mode;
-        }
-    }
-    
-    // add the constant f0 to the modulation
-    for (int i_samp=0; i_samp<bufferSize; ++i_samp)
-    {
-        freqHzBuffer[i_samp] = this->_f0 * (1.+freqHzBuffer[i_samp]); 
-    } 
-    
-    // compute audio signal
-    this->_sawtooth_f0.processReplacing_tvf(outputBuffer, bufferSize, freqHzBuffer);
+{
+    // Single pass over the block: sinusoidal LFO, DC cut, mode selection,
+    // f0 scaling, audio sawtooth, rescale and final DC cut are fused per sample.
+    // The oscillators and filters are copied to locals so that their state
+    // stays in registers for the whole block, and written back at the end.
+    Sawtooth sawtooth_fm = this->_sawtooth_fm;
+    Sawtooth sawtooth_f0 = this->_sawtooth_f0;
+    DCcutFilter dcCut1 = this->_DCcutFilter1;
+    DCcutFilter dcCut2 = this->_DCcutFilter2;
+    
+    // mode selection is block constant: blend weights instead of branching per sample
+    float square = this->_mode > 0 ? 1.f : 0.f;
+    float sine = 1.f - square;
+    float squareDepth = 0.5f * this->_mode;
+    float f0_normalized = this->_f0 / this->_fs;
     
-    // rescale to [-0.25;0.25] instead of [0 1]
     for (int i_samp=0; i_samp<bufferSize; ++i_samp)
     {
-        outputBuffer[i_samp] -= 0.5;
-        outputBuffer[i_samp] *= 0.5; // divide by 2 (to prevent clipping)
+        // sinusoidal LFO (table-based sine), DC cut solves the terrible case fm=0
+        float mod = dcCut1.process_tick(arm_sin_f32(2*M_PI*sawtooth_fm.process_tick()) * 0.5f);
+        
+        // other modes for computing fm (square-based modulations)
+        float sq = mod > -0.00001f ? squareDepth : -squareDepth;
+        mod = sine * mod + square * sq;
+        
+        // add the constant f0 to the modulation and compute audio signal
+        float val = sawtooth_f0.process_tick_tvf(f0_normalized * (1.f + mod));
+        
+        // rescale to [-0.25;0.25] instead of [0 1], then cut DC (now for the case f0=0)
+        outputBuffer[i_samp] = dcCut2.process_tick((val - 0.5f) * 0.5f);
     }
     
-    // and finally cut DC from the audio signal (now for the case f0=0)
-    this->_DCcutFilter2.processReplacing(outputBuffer, outputBuffer, bufferSize);
+    this->_sawtooth_fm = sawtooth_fm;
+    this->_sawtooth_f0 = sawtooth_f0;
+    this->_DCcutFilter1 = dcCut1;
+    this->_DCcutFilter2 = dcCut2;
 }
 
 
@@ -369,6 +387,7 @@ public:
         }
         else
         {
+            this->_tr60 = tr60;
             // set feedback gains appropriately
             for (int i_chan=0; i_chan<Nchannels; i_chan++)
             {
@@ -418,6 +437,7 @@ private:
 ReverbFDN::ReverbFDN(float fs, float tr60, float drywet)
 {
     this->_fs = fs;
+    this->_tr60 = -1.; // force computation of the feedback gains
     this->setDryWet(drywet);
     this->setTR60(tr60);
 }
@@ -511,8 +531,7 @@ public:
         this->_reverbFDN.setTR60(tr60);
     }
 
-  void setBuffers(AudioBuffer* freqHzBuffer, AudioBuffer* delayBuffer){
-    _FMSynth.setBuffer(freqHzBuffer);
+  void setBuffers(AudioBuffer* delayBuffer){
     _reverbFDN.setBuffer(delayBuffer);
   }
 private:
@@ -555,8 +574,7 @@ public:
       registerParameter(PARAMETER_C, "mode");
       registerParameter(PARAMETER_D, "tr60");
 
-      this->_Siren.setBuffers(createMemoryBuffer(1, getBlockSize()), 
-			      createMemoryBuffer(1, sirenDelayBufferSize));
+      this->_Siren.setBuffers(createMemoryBuffer(1, sirenDelayBufferSize));
     }
     
     void processAudio(AudioBuffer &buffer) 
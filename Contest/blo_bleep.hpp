@@ -10,10 +10,16 @@
 
 #include "StompBox.h"
 
+#define BLO_BLEEP_RAMP 32 // anti-click ramp between gates, in samples
+
 class little_blo_bleep : public Patch {
 
   int current_sample; // currently processed sample
   float blo_bleep; // our bloopity bleepity gain :)
+  float gain; // gain actually applied, ramps towards blo_bleep
+  float ramp_step;
+  int ramp_remaining;
+  float* gains; // per block gate, shared by all channels
 
   int num_bits; // number of bits in int >> should be 32, but we will calculate it to be safe.
   int num_bits_less1;
@@ -28,10 +34,15 @@ class little_blo_bleep : public Patch {
 
     little_blo_bleep () {
       current_sample = 0;
+      blo_bleep = 0;
+      gain = 0;
+      ramp_step = 0;
+      ramp_remaining = 0;
       num_bits = sizeof (int) * 8;
       num_bits_less1 = num_bits - 1;
       num_shifts = 0;
         maxBpm = 10000;
+      gains = createMemoryBuffer(1, getBlockSize())->getSamples(0);
         
       registerParameter(PARAMETER_A, "Pattern");
       registerParameter(PARAMETER_B, "BPM");
@@ -54,31 +65,57 @@ class little_blo_bleep : public Patch {
       //
       pattern = getParameterValue (PARAMETER_A) * maxBpm ; // pick the current integer as our unique bit pattern
       bpm     = getParameterValue (PARAMETER_B) * maxBpm ; // our bpm. whats the max of PARAMETER_B? that will be max bpm too.
+      if (bpm < 1) bpm = 1; // guard against divide by zero at the bottom of the knob
       float bps = bpm / 60.0; // beats per second
       int samples_per_beat = (int) (getSampleRate() / bps + 0.5); // we bit shift the pattern every beat
 
-      
-
-      // apply blo_bleep to input buffer!
-
-    for(int ch = 0; ch<buffer.getChannels(); ++ch)
-    {
-      float* buf = buffer.getSamples(ch);
-      
-      for (int i = 0; i < size; ++i) 
+      // work out where the gate switches in this block, then fill each
+      // segment with a constant (or ramping) gain >> cost does not depend on the bpm
+      int i = 0;
+      while (i < size)
         {
-          
-          if (++current_sample >= samples_per_beat) 
-	    {
+          int run = samples_per_beat - 1 - current_sample; // samples left before the next beat
+          if (run > 0)
+            {
+              if (run > size - i) run = size - i;
+              fill (gains + i, run);
+              current_sample += run;
+              i += run;
+            }
+          else
+            {
               current_sample = 0;
               blo_bleep = (pattern >> num_shifts) & extract; // extract the right most bit >> bloopity, bleepity!
               if (++num_shifts >= num_bits_less1) num_shifts = 1;
-            } 
-           buf[i] = blo_bleep * buf[i]; // 1 or 0 gain based on extracted bit pattern, bloppity bleepity!
+              ramp_step = (blo_bleep - gain) / BLO_BLEEP_RAMP;
+              ramp_remaining = gain == blo_bleep ? 0 : BLO_BLEEP_RAMP;
+              fill (gains + i, 1);
+              i++;
+            }
         }
-       
+
+      // apply blo_bleep to input buffer! same gate on every channel
+    for(int ch = 0; ch<buffer.getChannels(); ++ch)
+    {
+      float* buf = buffer.getSamples(ch);
+      arm_mult_f32 (buf, gains, buf, size); // 1 or 0 gain based on extracted bit pattern, bloppity bleepity!
     }
 
   }
 
+  private:
+
+    // write n samples of gate, ramping first if a transition is in progress
+    void fill (float* out, int n)
+  {
+      while (n > 0 && ramp_remaining > 0)
+        {
+          gain = --ramp_remaining ? gain + ramp_step : blo_bleep;
+          *out++ = gain;
+          n--;
+        }
+      if (n > 0)
+        arm_fill_f32 (gain, out, n);
+  }
+
 };
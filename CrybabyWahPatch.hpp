@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ 
+ 
+ LICENSE:
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+
+/* Crybaby wah from the Faust effect.lib, native version by the OWL team */
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __CrybabyWahPatch_hpp__
+#define __CrybabyWahPatch_hpp__
+
+#include "StompBox.h"
+#include "WahEngine.hpp"
+
+/*
+  Native version of Faust/Crybaby.dsp: pedal position on A.
+*/
+class CrybabyWahPatch : public Patch {
+private:
+  WahEngine wah;
+public:
+  CrybabyWahPatch(){
+    registerParameter(PARAMETER_A, "AhAh");
+    wah.setSampleRate(getSampleRate());
+  }
+  void processAudio(AudioBuffer &buffer){
+    float* samples = buffer.getSamples(0);
+    wah.process(&samples, 1, getParameterValue(PARAMETER_A), buffer.getSize());
+  }
+};
+
+#endif // __CrybabyWahPatch_hpp__
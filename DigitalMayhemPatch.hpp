@@ -40,6 +40,8 @@ private:
 	float freq;
 	int update_freq_cnt;
 	float prev_freq;
+	float phase;		//modulator phase in cycles, wrapped to [0,1)
+	float* mod;		//per-block rectified cosine modulator
 	const float fs = 48000;
 	const float pi = 3.14159;
 
@@ -54,7 +56,8 @@ public:
 	inc_flag = 1;
 	update_freq_cnt = 0;
 	prev_freq = 0;
-	
+	phase = 0;
+	mod = createMemoryBuffer(1, getBlockSize())->getSamples(0);
   }
   void processAudio(AudioBuffer &buffer)
   {
@@ -66,7 +69,6 @@ public:
 	
 	float mayhem_rate = getParameterValue(PARAMETER_B);
 	mayhem_rate *= 0.03;
-	float mayhem = 1;
 	
 	if(abs(getParameterValue(PARAMETER_C)*2+1-prev_freq)>0.01)	//if the knob was turned
 	{
@@ -81,16 +83,32 @@ public:
 	
     //for(int ch=0; ch<buffer.getChannels(); ++ch){
       float* buf = buffer.getSamples(0);
+      // render the modulator for the whole block with a rotating phasor:
+      // one sin/cos pair per block re-seeds the recurrence from the wrapped
+      // phase accumulator, so there is no long-term drift
+      float inc = mayhem_freq/size;	//cycles per sample
+      float c = arm_cos_f32(2*pi*phase);
+      float s = arm_sin_f32(2*pi*phase);
+      float dc = arm_cos_f32(2*pi*inc);
+      float ds = arm_sin_f32(2*pi*inc);
       for(int i=0; i<size; ++i)
 		{
-			if(i%samp_freq==0)
-			{	
-				buf[i] = buf[i]*((1-mayhem)+mayhem*abs(cos(2*pi*mayhem_freq*(i+update_freq_cnt*size)/size)));
-				samp = buf[i];	
-			}
-			else
-				buf[i] = samp;
-//				buf[i] = samp*(1-mayhem)+buf[i]*mayhem*abs(cos(2*pi*mayhem_freq*(i+update_freq_cnt*size)/size));
+			mod[i] = c;
+			float tmp = c*dc - s*ds;
+			s = s*dc + c*ds;
+			c = tmp;
+		}
+      arm_abs_f32(mod, mod, size);
+      arm_mult_f32(buf, mod, buf, size);
+      phase += inc*size;
+      phase -= floorf(phase);
+      // sample and hold at samp_freq
+      for(int i=0; i<size; i+=samp_freq)
+		{
+			samp = buf[i];
+			int end = i+samp_freq < size ? i+samp_freq : size;
+			for(int j=i+1; j<end; ++j)
+				buf[j] = samp;
 		}
 //		update_freq_cnt++;
 //		if(update_freq_cnt == 10)
@@ -0,0 +1,71 @@
+#ifndef __EchoEngine_hpp__
+#define __EchoEngine_hpp__
+
+#define ECHO_LANES 2
+
+/**
+   Stereo feedback echo, after the Faust music.lib echo: y = x + fb*delayed.
+   Both delay lines live in one interleaved ring, arena[2*n + lane], so a
+   read or write of the two channels touches one pair of adjacent floats.
+   The feedback path has a one pole low pass per lane and a cross-feed
+   that sends part of each lane's echo into the other, for ping-pong.
+*/
+class EchoEngine {
+private:
+  float* arena;
+  unsigned int mask; // ring frames - 1, power of two
+  unsigned int writeIndex;
+  float lp[ECHO_LANES]; // feedback filter states
+public:
+  EchoEngine() : arena(NULL), mask(0), writeIndex(0) {
+    lp[0] = lp[1] = 0.0f;
+  }
+  /* number of ring frames to hold delays of up to maxDelay samples */
+  static unsigned int getRingSize(int maxDelay){
+    unsigned int frames = 1;
+    while(frames < (unsigned int)maxDelay + 1)
+      frames <<= 1;
+    return frames;
+  }
+  /* buf must hold ECHO_LANES*frames floats, frames a power of two */
+  void initialise(float* buf, unsigned int frames){
+    arena = buf;
+    mask = frames-1;
+    writeIndex = 0;
+    memset(arena, 0, ECHO_LANES*frames*sizeof(float));
+  }
+  /*
+    delay in samples, feedback 0 to 1, damping 0 (none) to 1 (dark),
+    cross 0 (separate lanes) to 1 (full ping-pong).
+    right may be the same buffer as left for mono.
+  */
+  void process(float* left, float* right, int size, int delay,
+	       float feedback, float damping, float cross){
+    if(delay < 1)
+      delay = 1;
+    else if(delay > (int)mask)
+      delay = mask;
+    float coeff = 1.0f - damping*0.95f;
+    float same = feedback*(1.0f - cross);
+    float other = feedback*cross;
+    float s[ECHO_LANES] = { lp[0], lp[1] };
+    unsigned int w = writeIndex;
+    for(int i=0; i<size; ++i){
+      float* rd = arena + ((w - delay) & mask)*ECHO_LANES;
+      float* wr = arena + (w & mask)*ECHO_LANES;
+      for(int k=0; k<ECHO_LANES; ++k)
+	s[k] += coeff*(rd[k] - s[k]);
+      float x[ECHO_LANES] = { left[i], right[i] };
+      for(int k=0; k<ECHO_LANES; ++k)
+	wr[k] = x[k] + same*s[k] + other*s[k^1];
+      right[i] = wr[1];
+      left[i] = wr[0];
+      w++;
+    }
+    writeIndex = w;
+    lp[0] = s[0];
+    lp[1] = s[1];
+  }
+};
+
+#endif // __EchoEngine_hpp__
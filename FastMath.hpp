@@ -0,0 +1,44 @@
+#ifndef __FastMath_hpp__
+#define __FastMath_hpp__
+
+#include <stdint.h>
+
+/**
+   Polynomial approximations of log2, exp2 and pow for audio rate use,
+   where the libm versions are too slow on the Cortex M4.
+   fastlog2f is accurate to about 1e-6 and fastexp2f to about 2e-5 (relative).
+ */
+
+/* log2 of a positive, normal x */
+static inline float fastlog2f(float x){
+  union { float f; uint32_t i; } v = { x };
+  float e = (float)(int)((v.i >> 23) & 0xff) - 127;
+  v.i = (v.i & 0x007fffff) | 0x3f800000; // mantissa in [1,2)
+  // log(m) = 2*atanh(s) with s = (m-1)/(m+1), |s| <= 1/3
+  float s = (v.f - 1.0f) / (v.f + 1.0f);
+  float s2 = s*s;
+  float ln = s * (2.0f + s2 * (0.666666667f + s2 * (0.4f + s2 * (0.285714286f + s2 * 0.222222222f))));
+  return e + ln * 1.442695041f;
+}
+
+static inline float fastexp2f(float x){
+  if(x < -126.0f)
+    x = -126.0f;
+  else if(x > 127.0f)
+    x = 127.0f;
+  int xi = (int)x;
+  if(xi > x)
+    xi--; // floor
+  float f = (x - xi) * 0.693147181f;
+  // Taylor series of e^f for f in [0, ln2)
+  float p = 1.0f + f * (1.0f + f * (0.5f + f * (0.166666667f + f * (0.041666667f + f * (0.008333333f + f * 0.001388889f)))));
+  union { uint32_t i; float f; } v = { (uint32_t)(xi + 127) << 23 };
+  return v.f * p;
+}
+
+/* x^y for positive x */
+static inline float fastpowf(float x, float y){
+  return fastexp2f(y * fastlog2f(x));
+}
+
+#endif // __FastMath_hpp__
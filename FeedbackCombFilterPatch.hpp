@@ -28,95 +28,108 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define __FeedbackCombFilter_h__
 
 #include "StompBox.h"
-#include "JuceHeader.h"
-class FeedbackCombFilter : public Patch {
+
+#define COMB_VOICES 4
+#define COMB_MIN_FREQUENCY 10 // longest delay, in Hz
+
+class FeedbackCombFilterPatch : public Patch {
 public:
-	FeedbackCombFilter():
-		delayBuffer_(1,1)
+	FeedbackCombFilterPatch() : delayWritePosition_(0)
 	{
 		registerParameter(PARAMETER_A, "Frequency");
 		registerParameter(PARAMETER_B, "Spread");
 		registerParameter(PARAMETER_C, "Feedback");
 		registerParameter(PARAMETER_D, "Depth");
-		delayBuffer_.setSize(2, delayBufferLength_);
-		delayBuffer_.clear();
+		sampleRate_ = getSampleRate();
+		// power of two ring, long enough for the lowest frequency plus interpolation
+		int length = 1;
+		while(length < sampleRate_ / COMB_MIN_FREQUENCY + 2)
+			length <<= 1;
+		delayBufferMask_ = length - 1;
+		delayBuffer_ = createMemoryBuffer(2, length);
+		delayBuffer_->clear();
+		blockSmooth_ = powf(0.999, getBlockSize());
+		for (int j = 0; j < COMB_VOICES; j++)
+			currentDelays_[j] = -1; // set on the first block
+		for (int ch = 0; ch < 2; ch++){
+			compression_[ch] = 1;
+			feedback_[ch] = 0;
+		}
 	}
 	void processAudio(AudioBuffer &buffer){
-		frequency_ = 10 * pow(40, getParameterValue(PARAMETER_A));
-		spread_ = getParameterValue(PARAMETER_B);
-		float newFeedback = getParameterValue(PARAMETER_C)*(1.0 / (numVoices_ - 1))*1.6; //this range allows to push above the limit but should be limited by the limiter below
-		depth_ = getParameterValue(PARAMETER_D);
-		for (int j = 0; j < numVoices_ - 1; j++){
-			frequencies_[j] = frequency_*(1 + spread_*j);
-			newDelays_[j] = 1 / frequencies_[j];
+		float frequency = COMB_MIN_FREQUENCY * powf(40, getParameterValue(PARAMETER_A));
+		float spread = getParameterValue(PARAMETER_B);
+		float newFeedback = getParameterValue(PARAMETER_C)*(1.0 / COMB_VOICES)*1.6; //this range allows to push above the limit but should be limited by the limiter below
+		float depth = getParameterValue(PARAMETER_D);
+		const int numSamples = buffer.getSize();
+
+		// delay times in samples, smoothed at block rate and ramped linearly across the block
+		float startDelays[COMB_VOICES];
+		float deltaDelays[COMB_VOICES];
+		for (int j = 0; j < COMB_VOICES; j++){
+			float target = sampleRate_ / (frequency*(1 + spread*j));
+			if (currentDelays_[j] < 0)
+				currentDelays_[j] = target;
+			startDelays[j] = currentDelays_[j];
+			currentDelays_[j] = target + (currentDelays_[j] - target) * blockSmooth_;
+			deltaDelays[j] = (currentDelays_[j] - startDelays[j]) / numSamples;
 		}
-		const int numSamples = buffer.getSize();          // How many samples in the buffer for this block?
-		int dpw; // dpr = delay read pointer; dpw = delay write pointer
-		float dpr;
-		static float compression = 1;
-		//for (int channel = 0; channel < buffer.getChannels(); ++channel)
-		for (int channel = 0; channel < 1; ++channel)
+
+		int channels = min(buffer.getChannels(), delayBuffer_->getChannels());
+		unsigned int mask = delayBufferMask_;
+		for (int channel = 0; channel < channels; ++channel)
 		{
-			// channelData is an array of length numSamples which contains the audio for one channel
 			float* channelData = buffer.getSamples(channel);
-			// delayData is the circular buffer for implementing delay on
-			float* delayData = delayBuffer_.getSampleData(0);
-			dpw = delayWritePosition_;
+			float* delayData = delayBuffer_->getSamples(channel);
+			float delays[COMB_VOICES];
+			for (int j = 0; j < COMB_VOICES; j++)
+				delays[j] = startDelays[j];
+			float compression = compression_[channel];
+			float feedback = feedback_[channel];
+			unsigned int dpw = delayWritePosition_;
 			for (int i = 0; i < numSamples; ++i)
 			{
-				//channelData[i] = rand() / (float)RAND_MAX * 2 - 1;
-				float in = channelData[i];
-				in /= numVoices_;
-				float interpolatedSample = 0.0;
-				for (int j = 0; j < numVoices_ - 1; ++j)
+				float sum = 0;
+				bool clipped = false;
+				for (int j = 0; j < COMB_VOICES; ++j)
 				{
-					currentDelays_[j] = newDelays_[j] * 0.001 + currentDelays_[j] * 0.999;
-					dpr = fmodf((float)dpw - (float)(currentDelays_[j] * getSampleRate()) + (float)delayBufferLength_,
-						(float)delayBufferLength_);
-					//--linear interpolation
-					// Find the fraction by which the read pointer sits between two
-					// samples and use this to adjust weights of the samples
-					float fraction = dpr - floorf(dpr);
-					int previousSample = (int)floorf(dpr);
-					int nextSample = (previousSample + 1) % delayBufferLength_;
-					interpolatedSample = fraction*delayData[nextSample]
-						+ (1.0f - fraction)*delayData[previousSample];
-					//linear interpolation--
+					// read pointer is dpw - delay: the integer part of the delay
+					// gives the newer sample, its fraction weighs in the older one
+					int whole = (int)delays[j];
+					float fraction = delays[j] - whole;
+					unsigned int newer = (dpw - whole) & mask;
+					float interpolatedSample = (1.0f - fraction)*delayData[newer]
+						+ fraction*delayData[(newer - 1) & mask];
+					delays[j] += deltaDelays[j];
 					if (!(interpolatedSample < 1 && interpolatedSample >= -1)) //apply a simple limiter to the feedback loop
 					{
 						interpolatedSample = interpolatedSample>1 ? 0.9999 : -1;
-						//interpolatedSample = rand() / (float)RAND_MAX * 2 - 1;
-						compression *= 0.999;
-					}
-					compression = compression*0.9 + 0.1;
-					feedback_ = newFeedback*0.1*compression + feedback_*0.9;
-
-					// Store the output sample in the buffer, which starts by containing the input sample
-					if (j == 0) { //if it's the first voice, overwrite the delay buffer
-						delayData[dpw] = in;
+						clipped = true;
 					}
-					delayData[dpw] += interpolatedSample*feedback_; //otherwise sum back to it the feedback
-					channelData[i] += depth_ * interpolatedSample;
+					sum += interpolatedSample;
 				}
-				//channelData[i] *= 0.25;
-				if (++dpw >= delayBufferLength_)
-					dpw = 0;
+				if (clipped)
+					compression *= 0.999;
+				compression = compression*0.9 + 0.1;
+				feedback = newFeedback*0.1*compression + feedback*0.9;
+				delayData[dpw] = channelData[i] * (1.0f / (COMB_VOICES + 1)) + sum*feedback;
+				channelData[i] += depth * sum;
+				dpw = (dpw + 1) & mask;
 			}
+			compression_[channel] = compression;
+			feedback_[channel] = feedback;
 		}
-		delayWritePosition_ = dpw;
+		delayWritePosition_ = (delayWritePosition_ + numSamples) & mask;
 	}
 private:
-	AudioSampleBuffer delayBuffer_;
-	int delayWritePosition_=0;
-	int delayBufferLength_=10000;
-	float currentDelays_[4];
-	float newDelays_[4];
-	float frequencies_[4];
-	int numVoices_ = 5;
-	float frequency_;
-	float depth_;
-	float feedback_=0;
-	float spread_;
+	AudioBuffer* delayBuffer_;
+	unsigned int delayBufferMask_;
+	unsigned int delayWritePosition_;
+	float currentDelays_[COMB_VOICES];
+	float blockSmooth_;
+	float compression_[2]; // limiter state, per channel
+	float feedback_[2];
+	float sampleRate_;
 };
 
 #endif // _FeedbackCombFilter_h__
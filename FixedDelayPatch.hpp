@@ -28,31 +28,92 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define __FixedDelayPatch_hpp__
 
 #include "StompBox.h"
-#include "CircularBuffer.hpp"
+#include "CircularBufferQ15.hpp"
 #define REQUEST_BUFFER_SIZE 262144
+#define DELAY_MAX_HEADS 3
+#define DELAY_MAX_SLEW 0.5f // fastest change of delay time, in samples per sample
+
+/**
+ * Tape style read head: the delay time glides towards its target at a bounded
+ * rate, which bends the pitch like a varispeed tape instead of clicking.
+ * Each block the head reads one contiguous span of the ring and interpolates
+ * from it, so the cost does not depend on the delay time.
+ */
+class VarispeedHead {
+private:
+  float delay;
+public:
+  VarispeedHead() : delay(-1) {}
+  /* add gain times the head output to out; span must hold 2*size+4 samples */
+  void process(CircularBufferQ15& ring, float* span, float* out, int size, float target, float gain){
+    if(delay < 0)
+      delay = target;
+    float d0 = delay;
+    float maxStep = size * DELAY_MAX_SLEW;
+    float d1 = d0 + max(-maxStep, min(maxStep, target - d0));
+    float step = (d1 - d0) / size;
+    // positions relative to the write head are n - delay(n), linear over the block
+    float first = -d0;
+    float last = size - 1 - d1;
+    int start = (int)floorf(min(first, last));
+    int len = (int)ceilf(max(first, last)) - start + 2;
+    ring.read(span, len, -start);
+    float pos = first - start;
+    float inc = 1.0f - step;
+    for(int n=0; n<size; ++n){
+      int i = (int)pos;
+      float frac = pos - i;
+      out[n] += gain * (span[i] + frac * (span[i+1] - span[i]));
+      pos += inc;
+    }
+    delay = d1;
+  }
+};
 
 class FixedDelayPatch : public Patch {
     
 private:
-  CircularBuffer delayBuffer;
+  CircularBufferQ15 delayBuffer;
+  VarispeedHead heads[DELAY_MAX_HEADS];
+  float* span;
+  float* delayed;
+  float minDelay;
+  float maxDelay;
     
 public:
   FixedDelayPatch() {
-    AudioBuffer* buffer = createMemoryBuffer(1, REQUEST_BUFFER_SIZE);
-    delayBuffer.initialise(buffer->getSamples(0), buffer->getSize());
+    // Q15 samples take half the space: a float buffer of half the length holds the whole delay
+    AudioBuffer* buffer = createMemoryBuffer(1, REQUEST_BUFFER_SIZE/2);
+    delayBuffer.initialise((q15_t*)buffer->getSamples(0), REQUEST_BUFFER_SIZE);
+    span = createMemoryBuffer(1, 2*getBlockSize()+4)->getSamples(0);
+    delayed = createMemoryBuffer(1, getBlockSize())->getSamples(0);
+    // heads must read behind the block that is about to be written
+    minDelay = getBlockSize() + 2;
+    maxDelay = REQUEST_BUFFER_SIZE - 4;
     registerParameter(PARAMETER_A, "Feedback");
     registerParameter(PARAMETER_B, "Mix");
-    registerParameter(PARAMETER_C, "");    
-    registerParameter(PARAMETER_D, "");    
+    registerParameter(PARAMETER_C, "Time");
+    registerParameter(PARAMETER_D, "Heads");
   }
   void processAudio(AudioBuffer &buffer) {
     float* x = buffer.getSamples(0);
+    int size = buffer.getSize();
     float feedback = getParameterValue(PARAMETER_A);
     float mix = getParameterValue(PARAMETER_B);
-    for(int n = 0; n < buffer.getSize(); n++){
-      x[n] = delayBuffer.tail()*mix + x[n]*(1.0f-mix);
-      delayBuffer.write(feedback * x[n]);
+    float time = getParameterValue(PARAMETER_C);
+    float target = minDelay + time*time*(maxDelay-minDelay);
+    // one head, or up to three evenly spaced heads
+    int numHeads = 1 + (int)(getParameterValue(PARAMETER_D)*(DELAY_MAX_HEADS-1) + 0.5f);
+    memset(delayed, 0, size*sizeof(float));
+    for(int h=0; h<numHeads; ++h){
+      float headDelay = max(minDelay, target*(h+1)/numHeads);
+      heads[h].process(delayBuffer, span, delayed, size, headDelay, 1.0f/numHeads);
     }
+    arm_scale_f32(delayed, mix, delayed, size);
+    arm_scale_f32(x, 1.0f-mix, x, size);
+    arm_add_f32(x, delayed, x, size);
+    arm_scale_f32(x, feedback, delayed, size);
+    delayBuffer.write(delayed, size);
   }
 };
 
@@ -42,8 +42,7 @@ public:
     int size = buffer.getSize();
     for(int ch=0; ch<buffer.getChannels(); ++ch){
       float* buf = buffer.getSamples(ch);
-      for(int i=0; i<size; ++i)
-	buf[i] = gain*buf[i];
+      arm_scale_f32(buf, gain, buf, size);
     }
   }
 };
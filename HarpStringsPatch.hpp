@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ 
+ 
+ LICENSE:
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+
+/* created by the OWL team 2013 */
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __HarpStringsPatch_hpp__
+#define __HarpStringsPatch_hpp__
+
+#include "StompBox.h"
+#include "StringBank.hpp"
+
+/*
+  Native port of Faust/Harp.dsp: six strings on a StringBank, a string is
+  plucked when the (smoothed) hand position sweeps across it.
+*/
+#define HARP_STRINGS 6
+
+class HarpStringsPatch : public Patch {
+private:
+  StringBank strings;
+  float position[HARP_STRINGS];
+  float hand;
+  float smoothing; // per block coefficient of the hand smoother
+public:
+  HarpStringsPatch() : hand(0) {
+    registerParameter(PARAMETER_A, "Level");
+    registerParameter(PARAMETER_B, "Attenuation");
+    registerParameter(PARAMETER_C, "Hand");
+    registerParameter(PARAMETER_D, "");
+    float fs = getSampleRate();
+    float maxPeriod = fs / 440.0f;
+    unsigned int rows = StringBank::getRingSize(maxPeriod);
+    strings.initialise(createMemoryBuffer(1, rows*STRINGBANK_LANES)->getSamples(0), rows);
+    for(int i=0; i<HARP_STRINGS; ++i){
+      float p = (i+0.5f)/HARP_STRINGS;
+      position[i] = p;
+      strings.setString(i, fs / (440.0f * powf(2.0f, i/5.0f)), 0, 0, sqrtf(1-p), sqrtf(p));
+    }
+    // the Faust smoother is y = 0.9*y' + 0.1*x per sample
+    smoothing = powf(0.9f, getBlockSize());
+  }
+  void processAudio(AudioBuffer &buffer){
+    float level = getParameterValue(PARAMETER_A);
+    float att = getParameterValue(PARAMETER_B) * 0.01f;
+    float target = getParameterValue(PARAMETER_C);
+    float tap = 0.5f * (1.0f - att);
+    float last = hand;
+    hand = target + (hand - target) * smoothing;
+    float lo = min(last, hand);
+    float hi = max(last, hand);
+    for(int i=0; i<HARP_STRINGS; ++i){
+      strings.setTaps(i, tap, tap);
+      if(lo < position[i] && position[i] < hi)
+	strings.pluck(i);
+    }
+    float* left = buffer.getSamples(0);
+    float* right = buffer.getChannels() > 1 ? buffer.getSamples(1) : NULL;
+    strings.process(left, right, buffer.getSize(), level*level);
+  }
+};
+
+#endif // __HarpStringsPatch_hpp__
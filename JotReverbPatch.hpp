@@ -66,11 +66,22 @@ IMPLEMENTATION NOTES:
     why the processing could not be done in even larger chunks, as long as there is
     enough memory available (signal storage is proportional to CHUNK length.)
  
+    The signals of the eight lines are stored interleaved, lines[8*n + line], so the
+    damping filters and the feedback matrix work on all eight lines of a sample at once
+    (eight lanes with a fixed trip count). The feedback matrix is the 8x8 Hadamard matrix
+    with its rows permuted, evaluated as a fast Walsh-Hadamard transform (24 adds).
+    Both inputs feed every line and both outputs tap every line, through orthogonal
+    +/-1 vectors, so the reverb is true stereo.
+ 
+    Early reflections are up to JOT_EARLY_TAPS taps per side read from the pre delay
+    lines, which already hold the recent input. The taps are spread over the history left
+    after the pre delay, scaled by the room size, gathered once per CHUNK, and sent both to the output and into
+    the FDN input.
+ 
 OWL PATCH:
     The Patch that wraps this reverb algorithm is at the bottom of this file.
-    This version uses chunks of 32 to enable multiples of 32samples buffer sizes.
-    It has been tested as is on the Owl and works fine.
-    It is possible to revert CHUNK_SIZE TO 64 if need be.
+    Blocks that are a multiple of CHUNK_SIZE are processed in place. Other block sizes
+    go through input and output FIFOs of one CHUNK, at the cost of one CHUNK of latency.
  
     Parameters:
     A   room size
@@ -105,227 +116,232 @@ OWL PATCH:
 //       the delay lines then decrease exponentially in length.
 
 
+#define JOT_LINES				8
+#define JOT_STEREO_GAIN			0.707106781186548	// 1/sqrt(2): each input now feeds, and each output taps, all eight lines
+#define JOT_EARLY_TAPS			16					// early reflection taps per side, at most 16
+#define JOT_EARLY_LEVEL			0.5					// early reflections in the wet output
+#define JOT_EARLY_FEED			0.5					// early reflections into the FDN input
+
+
 typedef struct {
-	float		output[CHUNK_SIZE];					// each processing block owns its own output CHUNK
-	
 	float*		buffer_base;						// set to &(buffer[0])
 	int			index_mask;							// set to sizeof(buffer) - 1.  sizeof(buffer) must be power of 2
 	int			input_index;						// points to where in buffer samples go in
 	int			delay_samples;						// the delay amount in samples
+	int			written;							// samples written so far, up to BIG_DELAY_BUFFER_SIZE: older ones read as silence
 } delayBlock;
 
 
-typedef struct {
-	float		output[CHUNK_SIZE];					// each processing block owns its own output CHUNK
-    
-	float		b0;									// forward gain coefficient
-	float		a1;									// feedback coefficient minus 1
-	float		y1;									// feedback state
-} filterBlock;
-
-
 typedef struct {
 	float           left_output[CHUNK_SIZE];			// each processing block owns its own output CHUNK
 	float           right_output[CHUNK_SIZE];
+	float           left_predelay_output[CHUNK_SIZE];
+	float           right_predelay_output[CHUNK_SIZE];
     
 	float*			bigDelayBuffer;
-	char			primeNumberTable[PRIME_NUMBER_TABLE_SIZE];
+	
+	float			last_reverb_time;					// inputs of the last reverbSetParam() call, in samples
+	float			last_cutoff;
+	float			last_room_size;
+	int				last_room_prime;
+	int				line_prime[JOT_LINES];				// prime length of each feedback delay line
     
 	float			dry_coef;
+	float			wet_percent;
 	float			wet_coef0;
 	float			wet_coef1;
 	float			left_reverb_state;
 	float			right_reverb_state;
 	
-	float			node0[CHUNK_SIZE];
-	float			node1[CHUNK_SIZE];
-	float			node2[CHUNK_SIZE];
-	float			node3[CHUNK_SIZE];
-	float			node4[CHUNK_SIZE];
-	float			node5[CHUNK_SIZE];
-	float			node6[CHUNK_SIZE];
-	float			node7[CHUNK_SIZE];
+	int				left_early_delay[JOT_EARLY_TAPS];	// early reflection taps, in samples behind the pre delay input
+	int				right_early_delay[JOT_EARLY_TAPS];
+	float			early_coef;
+	float			last_pre_delay;
+	float			left_early[CHUNK_SIZE];
+	float			right_early[CHUNK_SIZE];
+	
+	float			nodes[CHUNK_SIZE*JOT_LINES];		// feedback matrix outputs, interleaved
+	float			lines[CHUNK_SIZE*JOT_LINES];		// delay line outputs, then damped in place, interleaved
 	
 	delayBlock		left_predelay;
 	delayBlock		right_predelay;
+	delayBlock		line[JOT_LINES];
+	
+	float			lpf_b0[JOT_LINES];					// damping filter coefficients and states, one lane per line
+	float			lpf_a1[JOT_LINES];
+	float			lpf_y1[JOT_LINES];
 	
-	delayBlock		delay0;
-	delayBlock		delay1;
-	delayBlock		delay2;
-	delayBlock		delay3;
-	delayBlock		delay4;
-	delayBlock		delay5;
-	delayBlock		delay6;
-	delayBlock		delay7;
-	
-	filterBlock		LPF0;
-	filterBlock		LPF1;
-	filterBlock		LPF2;
-	filterBlock		LPF3;
-	filterBlock		LPF4;
-	filterBlock		LPF5;
-	filterBlock		LPF6;
-	filterBlock		LPF7;
+	int				fifo_index;							// for block sizes that are not a multiple of CHUNK_SIZE
+	float			left_fifo[CHUNK_SIZE];
+	float			right_fifo[CHUNK_SIZE];
 } reverbBlock;
 
 
-void BuildPrimeTable(char* prime_number_table)
-{
-	int max_stride = (int)sqrt((float)PRIME_NUMBER_TABLE_SIZE);
-	
-	for(int i=0; i<PRIME_NUMBER_TABLE_SIZE; i++)
-	{
-		prime_number_table[i] = 1;									// initial value of all entries is 1
-	}
-	
-	prime_number_table[0] = 0;										// now we zero out any entry that is not prime
-	prime_number_table[1] = 0;
-	int stride = 2;													// start with stride set to the smallest prime
-	while (stride <= max_stride)
-	{
-		for(int i=2*stride; i<PRIME_NUMBER_TABLE_SIZE; i+=stride)	// start at the 2nd multiple of this prime, NOT the prime number itself!!!
-		{
-			prime_number_table[i] = 0;								// zero out table entries for all multiples of this prime number
-		}
-		stride++;
-		while (prime_number_table[stride] == 0)						// go to next non-zero entry which is the next prime
-		{
-			stride++;
-		}
-	}
-}
+// injection and extraction vectors: four distinct rows of the Hadamard matrix,
+// so that the two inputs and the two outputs are mutually orthogonal
+static const float jotLeftIn[JOT_LINES]   = {  1, -1,  1, -1,  1, -1,  1, -1 };
+static const float jotRightIn[JOT_LINES]  = {  1,  1, -1, -1,  1,  1, -1, -1 };
+static const float jotLeftOut[JOT_LINES]  = {  1,  1,  1,  1, -1, -1, -1, -1 };
+static const float jotRightOut[JOT_LINES] = {  1, -1, -1,  1,  1, -1, -1,  1 };
+
+// early reflection taps: position as a fraction of the tap span after the pre delay, and gain.
+// left and right use interleaved positions so that the two sides are decorrelated.
+// the gains have a sum of squares of 1 on each side.
+static const float jotLeftEarlyTime[16]  = { 0.013, 0.043, 0.087, 0.121, 0.173, 0.219, 0.271, 0.319,
+											 0.383, 0.437, 0.503, 0.571, 0.647, 0.719, 0.811, 0.907 };
+static const float jotRightEarlyTime[16] = { 0.021, 0.061, 0.101, 0.149, 0.193, 0.241, 0.293, 0.353,
+											 0.409, 0.467, 0.541, 0.607, 0.683, 0.761, 0.853, 0.953 };
+static const float jotLeftEarlyGain[16]  = { 0.397, -0.367, 0.339, 0.314, -0.290, 0.269, -0.248, 0.230,
+											 0.213, -0.197, 0.182, -0.168, 0.156, 0.144, -0.133, 0.123 };
+static const float jotRightEarlyGain[16] = { -0.397, 0.367, 0.339, -0.314, 0.290, -0.269, 0.248, 0.230,
+											 -0.213, 0.197, -0.182, 0.168, 0.156, -0.144, 0.133, 0.123 };
+
+
+// all primes below PRIME_NUMBER_TABLE_SIZE, in ascending order.
+// Kept as a const table so that it stays in flash and no sieve runs at patch load.
+#define PRIME_NUMBER_COUNT		965
+static const uint16_t primeNumberTable[PRIME_NUMBER_COUNT] = {
+	2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53,
+	59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127, 131,
+	137, 139, 149, 151, 157, 163, 167, 173, 179, 181, 191, 193, 197, 199, 211, 223,
+	227, 229, 233, 239, 241, 251, 257, 263, 269, 271, 277, 281, 283, 293, 307, 311,
+	313, 317, 331, 337, 347, 349, 353, 359, 367, 373, 379, 383, 389, 397, 401, 409,
+	419, 421, 431, 433, 439, 443, 449, 457, 461, 463, 467, 479, 487, 491, 499, 503,
+	509, 521, 523, 541, 547, 557, 563, 569, 571, 577, 587, 593, 599, 601, 607, 613,
+	617, 619, 631, 641, 643, 647, 653, 659, 661, 673, 677, 683, 691, 701, 709, 719,
+	727, 733, 739, 743, 751, 757, 761, 769, 773, 787, 797, 809, 811, 821, 823, 827,
+	829, 839, 853, 857, 859, 863, 877, 881, 883, 887, 907, 911, 919, 929, 937, 941,
+	947, 953, 967, 971, 977, 983, 991, 997, 1009, 1013, 1019, 1021, 1031, 1033, 1039, 1049,
+	1051, 1061, 1063, 1069, 1087, 1091, 1093, 1097, 1103, 1109, 1117, 1123, 1129, 1151, 1153, 1163,
+	1171, 1181, 1187, 1193, 1201, 1213, 1217, 1223, 1229, 1231, 1237, 1249, 1259, 1277, 1279, 1283,
+	1289, 1291, 1297, 1301, 1303, 1307, 1319, 1321, 1327, 1361, 1367, 1373, 1381, 1399, 1409, 1423,
+	1427, 1429, 1433, 1439, 1447, 1451, 1453, 1459, 1471, 1481, 1483, 1487, 1489, 1493, 1499, 1511,
+	1523, 1531, 1543, 1549, 1553, 1559, 1567, 1571, 1579, 1583, 1597, 1601, 1607, 1609, 1613, 1619,
+	1621, 1627, 1637, 1657, 1663, 1667, 1669, 1693, 1697, 1699, 1709, 1721, 1723, 1733, 1741, 1747,
+	1753, 1759, 1777, 1783, 1787, 1789, 1801, 1811, 1823, 1831, 1847, 1861, 1867, 1871, 1873, 1877,
+	1879, 1889, 1901, 1907, 1913, 1931, 1933, 1949, 1951, 1973, 1979, 1987, 1993, 1997, 1999, 2003,
+	2011, 2017, 2027, 2029, 2039, 2053, 2063, 2069, 2081, 2083, 2087, 2089, 2099, 2111, 2113, 2129,
+	2131, 2137, 2141, 2143, 2153, 2161, 2179, 2203, 2207, 2213, 2221, 2237, 2239, 2243, 2251, 2267,
+	2269, 2273, 2281, 2287, 2293, 2297, 2309, 2311, 2333, 2339, 2341, 2347, 2351, 2357, 2371, 2377,
+	2381, 2383, 2389, 2393, 2399, 2411, 2417, 2423, 2437, 2441, 2447, 2459, 2467, 2473, 2477, 2503,
+	2521, 2531, 2539, 2543, 2549, 2551, 2557, 2579, 2591, 2593, 2609, 2617, 2621, 2633, 2647, 2657,
+	2659, 2663, 2671, 2677, 2683, 2687, 2689, 2693, 2699, 2707, 2711, 2713, 2719, 2729, 2731, 2741,
+	2749, 2753, 2767, 2777, 2789, 2791, 2797, 2801, 2803, 2819, 2833, 2837, 2843, 2851, 2857, 2861,
+	2879, 2887, 2897, 2903, 2909, 2917, 2927, 2939, 2953, 2957, 2963, 2969, 2971, 2999, 3001, 3011,
+	3019, 3023, 3037, 3041, 3049, 3061, 3067, 3079, 3083, 3089, 3109, 3119, 3121, 3137, 3163, 3167,
+	3169, 3181, 3187, 3191, 3203, 3209, 3217, 3221, 3229, 3251, 3253, 3257, 3259, 3271, 3299, 3301,
+	3307, 3313, 3319, 3323, 3329, 3331, 3343, 3347, 3359, 3361, 3371, 3373, 3389, 3391, 3407, 3413,
+	3433, 3449, 3457, 3461, 3463, 3467, 3469, 3491, 3499, 3511, 3517, 3527, 3529, 3533, 3539, 3541,
+	3547, 3557, 3559, 3571, 3581, 3583, 3593, 3607, 3613, 3617, 3623, 3631, 3637, 3643, 3659, 3671,
+	3673, 3677, 3691, 3697, 3701, 3709, 3719, 3727, 3733, 3739, 3761, 3767, 3769, 3779, 3793, 3797,
+	3803, 3821, 3823, 3833, 3847, 3851, 3853, 3863, 3877, 3881, 3889, 3907, 3911, 3917, 3919, 3923,
+	3929, 3931, 3943, 3947, 3967, 3989, 4001, 4003, 4007, 4013, 4019, 4021, 4027, 4049, 4051, 4057,
+	4073, 4079, 4091, 4093, 4099, 4111, 4127, 4129, 4133, 4139, 4153, 4157, 4159, 4177, 4201, 4211,
+	4217, 4219, 4229, 4231, 4241, 4243, 4253, 4259, 4261, 4271, 4273, 4283, 4289, 4297, 4327, 4337,
+	4339, 4349, 4357, 4363, 4373, 4391, 4397, 4409, 4421, 4423, 4441, 4447, 4451, 4457, 4463, 4481,
+	4483, 4493, 4507, 4513, 4517, 4519, 4523, 4547, 4549, 4561, 4567, 4583, 4591, 4597, 4603, 4621,
+	4637, 4639, 4643, 4649, 4651, 4657, 4663, 4673, 4679, 4691, 4703, 4721, 4723, 4729, 4733, 4751,
+	4759, 4783, 4787, 4789, 4793, 4799, 4801, 4813, 4817, 4831, 4861, 4871, 4877, 4889, 4903, 4909,
+	4919, 4931, 4933, 4937, 4943, 4951, 4957, 4967, 4969, 4973, 4987, 4993, 4999, 5003, 5009, 5011,
+	5021, 5023, 5039, 5051, 5059, 5077, 5081, 5087, 5099, 5101, 5107, 5113, 5119, 5147, 5153, 5167,
+	5171, 5179, 5189, 5197, 5209, 5227, 5231, 5233, 5237, 5261, 5273, 5279, 5281, 5297, 5303, 5309,
+	5323, 5333, 5347, 5351, 5381, 5387, 5393, 5399, 5407, 5413, 5417, 5419, 5431, 5437, 5441, 5443,
+	5449, 5471, 5477, 5479, 5483, 5501, 5503, 5507, 5519, 5521, 5527, 5531, 5557, 5563, 5569, 5573,
+	5581, 5591, 5623, 5639, 5641, 5647, 5651, 5653, 5657, 5659, 5669, 5683, 5689, 5693, 5701, 5711,
+	5717, 5737, 5741, 5743, 5749, 5779, 5783, 5791, 5801, 5807, 5813, 5821, 5827, 5839, 5843, 5849,
+	5851, 5857, 5861, 5867, 5869, 5879, 5881, 5897, 5903, 5923, 5927, 5939, 5953, 5981, 5987, 6007,
+	6011, 6029, 6037, 6043, 6047, 6053, 6067, 6073, 6079, 6089, 6091, 6101, 6113, 6121, 6131, 6133,
+	6143, 6151, 6163, 6173, 6197, 6199, 6203, 6211, 6217, 6221, 6229, 6247, 6257, 6263, 6269, 6271,
+	6277, 6287, 6299, 6301, 6311, 6317, 6323, 6329, 6337, 6343, 6353, 6359, 6361, 6367, 6373, 6379,
+	6389, 6397, 6421, 6427, 6449, 6451, 6469, 6473, 6481, 6491, 6521, 6529, 6547, 6551, 6553, 6563,
+	6569, 6571, 6577, 6581, 6599, 6607, 6619, 6637, 6653, 6659, 6661, 6673, 6679, 6689, 6691, 6701,
+	6703, 6709, 6719, 6733, 6737, 6761, 6763, 6779, 6781, 6791, 6793, 6803, 6823, 6827, 6829, 6833,
+	6841, 6857, 6863, 6869, 6871, 6883, 6899, 6907, 6911, 6917, 6947, 6949, 6959, 6961, 6967, 6971,
+	6977, 6983, 6991, 6997, 7001, 7013, 7019, 7027, 7039, 7043, 7057, 7069, 7079, 7103, 7109, 7121,
+	7127, 7129, 7151, 7159, 7177, 7187, 7193, 7207, 7211, 7213, 7219, 7229, 7237, 7243, 7247, 7253,
+	7283, 7297, 7307, 7309, 7321, 7331, 7333, 7349, 7351, 7369, 7393, 7411, 7417, 7433, 7451, 7457,
+	7459, 7477, 7481, 7487, 7489, 7499, 7507, 7517, 7523, 7529, 7537, 7541, 7547, 7549, 7559, 7561,
+	7573, 7577, 7583, 7589, 7591
+};
 
 
-int FindNearestPrime(char* prime_number_table, int number)
+int FindNearestPrime(int number)						// largest prime not greater than number
 {
-	while (prime_number_table[number] == 0)
+	int lo = 0;
+	int hi = PRIME_NUMBER_COUNT-1;
+	if (number >= primeNumberTable[hi])
+		return primeNumberTable[hi];
+	while (lo < hi)										// binary search, invariant: table[lo] <= number < table[hi+1]
 	{
-		number--;
+		int mid = (lo + hi + 1) >> 1;
+		if (primeNumberTable[mid] <= number)
+			lo = mid;
+		else
+			hi = mid - 1;
 	}
-	return number;
+	return primeNumberTable[lo];
 }
 
 
 void reverbInitialize(reverbBlock* this_reverb)
 {
+	// max number of samples (plus one extra CHUNK) allocated for each delay in the big buffer
+	static const int	chunks[JOT_LINES+2]	= { 119, 119, 119, 112, 106, 100, 94, 89, 84, 79 };
+	// let's start out with predelay about 20ms and room size about 35ms x 44.1 kHz
+	static const int	delays[JOT_LINES+2]	= { 882, 882, 1544, 1457, 1375, 1297, 1224, 1155, 1090, 1029 };
+	delayBlock*	blocks[JOT_LINES+2];
+	blocks[0] = &this_reverb->left_predelay;
+	blocks[1] = &this_reverb->right_predelay;
+	for (int n=0; n<JOT_LINES; n++)
+		blocks[n+2] = &this_reverb->line[n];
+	
 	int	current_assigned_index = -CHUNK_SIZE;
-	current_assigned_index	+= ceil(119*CHUNK_SIZE*CHUNK_SIZE_RATIO);           // max number of samples (plus one extra CHUNK) allocated for this delay in this buffer
-	this_reverb->left_predelay.buffer_base		= this_reverb->bigDelayBuffer;
-	this_reverb->left_predelay.index_mask		= BIG_DELAY_BUFFER_SIZE-1;
-	this_reverb->left_predelay.input_index		= current_assigned_index;		// initial index must always be an integer multiple of CHUNK_SIZE
-	this_reverb->left_predelay.delay_samples		= 882;						// let's start out with predelay about 20ms x 44.1 kHz
-	
-	current_assigned_index	+= ceil(119*CHUNK_SIZE*CHUNK_SIZE_RATIO);  
-	this_reverb->right_predelay.buffer_base		= this_reverb->bigDelayBuffer;
-	this_reverb->right_predelay.index_mask		= BIG_DELAY_BUFFER_SIZE-1;
-	this_reverb->right_predelay.input_index		= current_assigned_index;
-	this_reverb->right_predelay.delay_samples	= 882;
-	
-	current_assigned_index	+= ceil(119*CHUNK_SIZE*CHUNK_SIZE_RATIO);  
-	this_reverb->delay0.buffer_base		= this_reverb->bigDelayBuffer;
-	this_reverb->delay0.index_mask		= BIG_DELAY_BUFFER_SIZE-1;
-	this_reverb->delay0.input_index		= current_assigned_index;
-	this_reverb->delay0.delay_samples	= 1544;									// let's start out with room size about 35ms x 44.1 kHz
-	
-	current_assigned_index	+= ceil(112*CHUNK_SIZE*CHUNK_SIZE_RATIO);
-	this_reverb->delay1.buffer_base		= this_reverb->bigDelayBuffer;
-	this_reverb->delay1.index_mask		= BIG_DELAY_BUFFER_SIZE-1;
-	this_reverb->delay1.input_index		= current_assigned_index;
-	this_reverb->delay1.delay_samples	= 1457;
-	
-	current_assigned_index	+= ceil(106*CHUNK_SIZE*CHUNK_SIZE_RATIO);
-	this_reverb->delay2.buffer_base		= this_reverb->bigDelayBuffer;
-	this_reverb->delay2.index_mask		= BIG_DELAY_BUFFER_SIZE-1;
-	this_reverb->delay2.input_index		= current_assigned_index;
-	this_reverb->delay2.delay_samples	= 1375;
-	
-	current_assigned_index	+= ceil(100*CHUNK_SIZE*CHUNK_SIZE_RATIO);
-	this_reverb->delay3.buffer_base		= this_reverb->bigDelayBuffer;
-	this_reverb->delay3.index_mask		= BIG_DELAY_BUFFER_SIZE-1;
-	this_reverb->delay3.input_index		= current_assigned_index;
-	this_reverb->delay3.delay_samples	= 1297;
-	
-	current_assigned_index	+= ceil(94*CHUNK_SIZE*CHUNK_SIZE_RATIO);
-	this_reverb->delay4.buffer_base		= this_reverb->bigDelayBuffer;
-	this_reverb->delay4.index_mask		= BIG_DELAY_BUFFER_SIZE-1;
-	this_reverb->delay4.input_index		= current_assigned_index;
-	this_reverb->delay4.delay_samples	= 1224;
-	
-	current_assigned_index	+= ceil(89*CHUNK_SIZE*CHUNK_SIZE_RATIO);
-	this_reverb->delay5.buffer_base		= this_reverb->bigDelayBuffer;
-	this_reverb->delay5.index_mask		= BIG_DELAY_BUFFER_SIZE-1;
-	this_reverb->delay5.input_index		= current_assigned_index;
-	this_reverb->delay5.delay_samples	= 1155;
-	
-	current_assigned_index	+= ceil(84*CHUNK_SIZE*CHUNK_SIZE_RATIO);
-	this_reverb->delay6.buffer_base		= this_reverb->bigDelayBuffer;
-	this_reverb->delay6.index_mask		= BIG_DELAY_BUFFER_SIZE-1;
-	this_reverb->delay6.input_index		= current_assigned_index;
-	this_reverb->delay6.delay_samples	= 1090;
-	
-	current_assigned_index	+= ceil(79*CHUNK_SIZE*CHUNK_SIZE_RATIO);
-	this_reverb->delay7.buffer_base		= this_reverb->bigDelayBuffer;
-	this_reverb->delay7.index_mask		= BIG_DELAY_BUFFER_SIZE-1;
-	this_reverb->delay7.input_index		= current_assigned_index;
-	this_reverb->delay7.delay_samples	= 1029;
-	
-	for(int i=0; i<BIG_DELAY_BUFFER_SIZE; i++)
+	for (int n=0; n<JOT_LINES+2; n++)
 	{
-		this_reverb->bigDelayBuffer[i] = 0;
+		current_assigned_index	+= ceil(chunks[n]*CHUNK_SIZE*CHUNK_SIZE_RATIO);
+		blocks[n]->buffer_base		= this_reverb->bigDelayBuffer;
+		blocks[n]->index_mask		= BIG_DELAY_BUFFER_SIZE-1;
+		blocks[n]->input_index		= current_assigned_index;			// initial index must always be an integer multiple of CHUNK_SIZE
+		blocks[n]->delay_samples	= delays[n];
+		blocks[n]->written			= 0;							// the big buffer is not cleared, see Delay()
 	}
 	
-	this_reverb->LPF0.a1 = -1.0;
-	this_reverb->LPF0.b0 = -ONE_OVER_SQRT8;
-	this_reverb->LPF0.y1 = 0.0;
-	for (int i=0; i<CHUNK_SIZE; i++)
-		this_reverb->LPF0.output[i] = 0.0;
-	
-	this_reverb->LPF1.a1 = -1.0;
-	this_reverb->LPF1.b0 = -ONE_OVER_SQRT8;
-	this_reverb->LPF1.y1 = 0.0;
-	for (int i=0; i<CHUNK_SIZE; i++)
-		this_reverb->LPF1.output[i] = 0.0;
-	
-	this_reverb->LPF2.a1 = -1.0;
-	this_reverb->LPF2.b0 = -ONE_OVER_SQRT8;
-	this_reverb->LPF2.y1 = 0.0;
-	for (int i=0; i<CHUNK_SIZE; i++)
-		this_reverb->LPF2.output[i] = 0.0;
-	
-	this_reverb->LPF3.a1 = -1.0;
-	this_reverb->LPF3.b0 = -ONE_OVER_SQRT8;
-	this_reverb->LPF3.y1 = 0.0;
-	for (int i=0; i<CHUNK_SIZE; i++)
-		this_reverb->LPF3.output[i] = 0.0;
-	
-	this_reverb->LPF4.a1 = -1.0;
-	this_reverb->LPF4.b0 = -ONE_OVER_SQRT8;
-	this_reverb->LPF4.y1 = 0.0;
-	for (int i=0; i<CHUNK_SIZE; i++)
-		this_reverb->LPF4.output[i] = 0.0;
-	
-	this_reverb->LPF5.a1 = -1.0;
-	this_reverb->LPF5.b0 = -ONE_OVER_SQRT8;
-	this_reverb->LPF5.y1 = 0.0;
-	for (int i=0; i<CHUNK_SIZE; i++)
-		this_reverb->LPF5.output[i] = 0.0;
-	
-	this_reverb->LPF6.a1 = -1.0;
-	this_reverb->LPF6.b0 = -ONE_OVER_SQRT8;
-	this_reverb->LPF6.y1 = 0.0;
-	for (int i=0; i<CHUNK_SIZE; i++)
-		this_reverb->LPF6.output[i] = 0.0;
-	
-	this_reverb->LPF7.a1 = -1.0;
-	this_reverb->LPF7.b0 = -ONE_OVER_SQRT8;
-	this_reverb->LPF7.y1 = 0.0;
-	for (int i=0; i<CHUNK_SIZE; i++)
-		this_reverb->LPF7.output[i] = 0.0;
+	for (int n=0; n<JOT_LINES; n++)
+	{
+		this_reverb->lpf_a1[n] = -1.0;
+		this_reverb->lpf_b0[n] = -ONE_OVER_SQRT8;
+		this_reverb->lpf_y1[n] = 0.0;
+	}
+	for (int i=0; i<CHUNK_SIZE*JOT_LINES; i++)
+		this_reverb->lines[i] = 0.0;
 	
 	this_reverb->left_reverb_state = 0.0;
 	this_reverb->right_reverb_state = 0.0;
 	
-	BuildPrimeTable(this_reverb->primeNumberTable);
+	this_reverb->fifo_index = 0;
+	for (int i=0; i<CHUNK_SIZE; i++)
+	{
+		this_reverb->left_fifo[i] = 0.0;
+		this_reverb->right_fifo[i] = 0.0;
+		this_reverb->left_output[i] = 0.0;
+		this_reverb->right_output[i] = 0.0;
+	}
+	
+	for (int j=0; j<JOT_EARLY_TAPS; j++)
+	{
+		this_reverb->left_early_delay[j] = 0;
+		this_reverb->right_early_delay[j] = 0;
+	}
+	this_reverb->early_coef = 0.0;
+	this_reverb->last_pre_delay = -1.0;
+	
+	this_reverb->wet_percent = -1.0;
+	this_reverb->last_reverb_time = -1.0;				// forces a full update on the first reverbSetParam()
+	this_reverb->last_cutoff = -1.0;
+	this_reverb->last_room_size = -1.0;
+	this_reverb->last_room_prime = -1;
+	for (int i=0; i<JOT_LINES; i++)
+		this_reverb->line_prime[i] = 0;
 }
 
 
@@ -362,85 +378,76 @@ void reverbSetParam(reverbBlock* this_reverb, float fSampleRate, float fPercentW
 		fPreDelaySamples = 0.0;
 	
 	
-	float	fCutoffCoef		= exp(-6.28318530717959*fCutOff);
+	this_reverb->left_predelay.delay_samples = (int)fPreDelaySamples;
+	this_reverb->right_predelay.delay_samples = (int)fPreDelaySamples;
 	
 	this_reverb->dry_coef	= 1.0 - wetCoef;
+	this_reverb->early_coef	= JOT_EARLY_LEVEL * wetCoef;
+	
+	if (fPreDelaySamples != this_reverb->last_pre_delay || fRoomSizeSamples != this_reverb->last_room_size)
+	{
+		// the pre delay lines hold MAX_ROOM_SIZE samples of history: the taps are spread over
+		// what is left of it after the pre delay, scaled by the room size, so that none is clamped
+		float	span = (MAX_ROOM_SIZE - fPreDelaySamples) * fRoomSizeSamples/MAX_ROOM_SIZE;	// fRoomSizeSamples <= MAX_ROOM_SIZE
+		for (int j=0; j<JOT_EARLY_TAPS; j++)
+		{
+			this_reverb->left_early_delay[j] = (int)(fPreDelaySamples + jotLeftEarlyTime[j]*span);
+			this_reverb->right_early_delay[j] = (int)(fPreDelaySamples + jotRightEarlyTime[j]*span);
+		}
+		this_reverb->last_pre_delay = fPreDelaySamples;
+	}
+	
+	bool	decay_changed	= fReverbTimeSamples != this_reverb->last_reverb_time || fCutOff != this_reverb->last_cutoff;
+	bool	room_changed	= fRoomSizeSamples != this_reverb->last_room_size;
+	if (!decay_changed && !room_changed && fPercentWet == this_reverb->wet_percent)
+		return;											// nothing below depends on the pre delay
+	
+	float	fCutoffCoef		= exp(-6.28318530717959*fCutOff);
 	
 	wetCoef	*= SQRT8 * (1.0 - exp(-13.8155105579643*fRoomSizeSamples/fReverbTimeSamples));			// additional attenuation for small room and long reverb time  <--  exp(-13.8155105579643) = 10^(-60dB/10dB)
     //  toss in whatever fudge factor you need here to make the reverb louder
 	this_reverb->wet_coef0	= wetCoef;
 	this_reverb->wet_coef1	= -fCutoffCoef*wetCoef;
+	this_reverb->wet_percent = fPercentWet;
+	
+	if (!decay_changed && !room_changed)
+		return;
 	
-	fCutoffCoef /=  (float)FindNearestPrime(this_reverb->primeNumberTable, (int)fRoomSizeSamples);
+	int		room_prime		= FindNearestPrime((int)fRoomSizeSamples);
+	fCutoffCoef /=  (float)room_prime;
 	
 	float	fDelaySamples	= fRoomSizeSamples;
 	float	beta			= -6.90775527898214/fReverbTimeSamples;			// 6.90775527898214 = log(10^(60dB/20dB))  <-- fReverbTime is RT60
-	float	f_prime_value;
-	int		prime_value;
 	
-	this_reverb->left_predelay.delay_samples = (int)fPreDelaySamples;
-	this_reverb->right_predelay.delay_samples = (int)fPreDelaySamples;
+	// the loop filters depend on the reverb time, the cutoff and the room prime (through fCutoffCoef),
+	// so when only the room size moves, lines that keep their prime keep their coefficients
+	bool	all_lines		= decay_changed || room_prime != this_reverb->last_room_prime;
+	for (int n=0; n<JOT_LINES; n++)
+	{
+		int	prime_value		= FindNearestPrime((int)fDelaySamples);
+		fDelaySamples *= ALPHA;
+		if (!all_lines && prime_value == this_reverb->line_prime[n])
+			continue;
+		this_reverb->line_prime[n] = prime_value;
+		this_reverb->line[n].delay_samples	= prime_value - CHUNK_SIZE;									// we subtract 1 CHUNK of delay, because this signal feeds back, causing an extra CHUNK delay
+		float	f_prime_value	= (float)prime_value;
+		this_reverb->lpf_a1[n]	= f_prime_value*fCutoffCoef - 1.0;
+		this_reverb->lpf_b0[n]	= ONE_OVER_SQRT8*exp(beta*f_prime_value)*(this_reverb->lpf_a1[n]);
+	}
 	
-	prime_value				= FindNearestPrime(this_reverb->primeNumberTable, (int)fDelaySamples);
-	this_reverb->delay0.delay_samples	= prime_value - CHUNK_SIZE;									// we subtract 1 CHUNK of delay, because this signal feeds back, causing an extra CHUNK delay
-	f_prime_value			= (float)prime_value;
-	this_reverb->LPF0.a1	= f_prime_value*fCutoffCoef - 1.0;
-	this_reverb->LPF0.b0	= ONE_OVER_SQRT8*exp(beta*f_prime_value)*(this_reverb->LPF0.a1);
-	fDelaySamples *= ALPHA;
-	
-	prime_value				= FindNearestPrime(this_reverb->primeNumberTable, (int)fDelaySamples);
-	this_reverb->delay1.delay_samples	= prime_value - CHUNK_SIZE;
-	f_prime_value			= (float)prime_value;
-	this_reverb->LPF1.a1	= f_prime_value*fCutoffCoef - 1.0;
-	this_reverb->LPF1.b0	= ONE_OVER_SQRT8*exp(beta*f_prime_value)*(this_reverb->LPF1.a1);
-	fDelaySamples *= ALPHA;
-	
-	prime_value				= FindNearestPrime(this_reverb->primeNumberTable, (int)fDelaySamples);
-	this_reverb->delay2.delay_samples	= prime_value - CHUNK_SIZE;
-	f_prime_value			= (float)prime_value;
-	this_reverb->LPF2.a1	= f_prime_value*fCutoffCoef - 1.0;
-	this_reverb->LPF2.b0	= ONE_OVER_SQRT8*exp(beta*f_prime_value)*(this_reverb->LPF2.a1);
-	fDelaySamples *= ALPHA;
-	
-	prime_value				= FindNearestPrime(this_reverb->primeNumberTable, (int)fDelaySamples);
-	this_reverb->delay3.delay_samples	= prime_value - CHUNK_SIZE;
-	f_prime_value			= (float)prime_value;
-	this_reverb->LPF3.a1	= f_prime_value*fCutoffCoef - 1.0;
-	this_reverb->LPF3.b0	= ONE_OVER_SQRT8*exp(beta*f_prime_value)*(this_reverb->LPF3.a1);
-	fDelaySamples *= ALPHA;
-	
-	prime_value				= FindNearestPrime(this_reverb->primeNumberTable, (int)fDelaySamples);
-	this_reverb->delay4.delay_samples	= prime_value - CHUNK_SIZE;
-	f_prime_value			= (float)prime_value;
-	this_reverb->LPF4.a1	= f_prime_value*fCutoffCoef - 1.0;
-	this_reverb->LPF4.b0	= ONE_OVER_SQRT8*exp(beta*f_prime_value)*(this_reverb->LPF4.a1);
-	fDelaySamples *= ALPHA;
-	
-	prime_value				= FindNearestPrime(this_reverb->primeNumberTable, (int)fDelaySamples);
-	this_reverb->delay5.delay_samples	= prime_value - CHUNK_SIZE;
-	f_prime_value			= (float)prime_value;
-	this_reverb->LPF5.a1	= f_prime_value*fCutoffCoef - 1.0;
-	this_reverb->LPF5.b0	= ONE_OVER_SQRT8*exp(beta*f_prime_value)*(this_reverb->LPF5.a1);
-	fDelaySamples *= ALPHA;
-	
-	prime_value				= FindNearestPrime(this_reverb->primeNumberTable, (int)fDelaySamples);
-	this_reverb->delay6.delay_samples	= prime_value - CHUNK_SIZE;
-	f_prime_value			= (float)prime_value;
-	this_reverb->LPF6.a1	= f_prime_value*fCutoffCoef - 1.0;
-	this_reverb->LPF6.b0	= ONE_OVER_SQRT8*exp(beta*f_prime_value)*(this_reverb->LPF6.a1);
-	fDelaySamples *= ALPHA;
-	
-	prime_value				= FindNearestPrime(this_reverb->primeNumberTable, (int)fDelaySamples);
-	this_reverb->delay7.delay_samples	= prime_value - CHUNK_SIZE;
-	f_prime_value			= (float)prime_value;
-	this_reverb->LPF7.a1	= f_prime_value*fCutoffCoef - 1.0;
-	this_reverb->LPF7.b0	= ONE_OVER_SQRT8*exp(beta*f_prime_value)*(this_reverb->LPF7.a1);
+	this_reverb->last_reverb_time = fReverbTimeSamples;
+	this_reverb->last_cutoff = fCutOff;
+	this_reverb->last_room_size = fRoomSizeSamples;
+	this_reverb->last_room_prime = room_prime;
 }
 
 
-void Delay(delayBlock* this_delay, float* input)
+//
+//	writes one CHUNK from input and reads one CHUNK, delay_samples later, to output.
+//	stride is the distance between consecutive samples in input and output (1, or JOT_LINES for the interleaved lines)
+//
+void Delay(delayBlock* this_delay, float* input, float* output, int stride)
 {
-	register float*		output		= &(this_delay->output[0]);
 	register float*		delay_ptr	= this_delay->buffer_base;
 	register int		index_mask	= this_delay->index_mask;
 	register int		index		= this_delay->input_index;
@@ -449,22 +456,36 @@ void Delay(delayBlock* this_delay, float* input)
 	
 	for(register int i=CHUNK_SIZE; i>0; i--)
 	{
-		*delay_ptr++ = *input++;						// no wrapping nor masking necessary because input index should always start as a multiple of CHUNK_SIZE
+		*delay_ptr++ = *input;							// no wrapping nor masking necessary because input index should always start as a multiple of CHUNK_SIZE
+		input += stride;
 	}
 	
 	index -=  this_delay->delay_samples;				// go to first delayed sample
 	delay_ptr = this_delay->buffer_base;
 	
-	for(register int i=CHUNK_SIZE; i>0; i--)
+	int		silent = this_delay->delay_samples - this_delay->written;	// samples from before the first write read as silence
+	if (silent > CHUNK_SIZE)
+		silent = CHUNK_SIZE;
+	for(register int i=silent; i>0; i--)				// only until the line has written delay_samples samples
+	{
+		*output = 0.0;
+		output += stride;
+		index++;
+	}
+	
+	for(register int i=CHUNK_SIZE - (silent > 0 ? silent : 0); i>0; i--)
 	{
 		index &= index_mask;							// must wrap index and
-		*output++ = delay_ptr[index++];					//                     reference from buffer base every sample
+		*output = delay_ptr[index++];					//                     reference from buffer base every sample
+		output += stride;
 	}
 	
 	index = this_delay->input_index;
 	index += CHUNK_SIZE;								// advance input index to pick up where we left off
 	index &= index_mask;								// this might need to wrap
 	this_delay->input_index = index;					// save state
+	if (this_delay->written < BIG_DELAY_BUFFER_SIZE)
+		this_delay->written += CHUNK_SIZE;
 }
 
 
@@ -474,203 +495,126 @@ void Delay(delayBlock* this_delay, float* input)
 //	for the nth delay line:		a1   = delay[n]/size * exp(-2*pi*fcutoff/Fs) - 1  =   pole - 1
 //								b0   = a1/sqrt(8) * 10^(-(60dB*delay[n]/RT60)/20dB)
 //
-void Filter(filterBlock* this_filter, float* input)
+//	all eight lines are filtered in place, one lane each, over the interleaved CHUNK
+//
+void Filter(reverbBlock* this_reverb, float* lines)
 {
-	register float*	output	= &(this_filter->output[0]);
-    
-	register float	b0 = this_filter->b0;				// feedforward coefficient
-	register float	a1 = this_filter->a1;				// feedback coefficient
-	
-	register float 	y1 = this_filter->y1;				// previous output
-    
-	register float	output_sample = y1;					// now is previous output sample, y[n-1]
+	float	b0[JOT_LINES], a1[JOT_LINES], y1[JOT_LINES];
+	for (int k=0; k<JOT_LINES; k++)
+	{
+		b0[k] = this_reverb->lpf_b0[k];
+		a1[k] = this_reverb->lpf_a1[k];
+		y1[k] = this_reverb->lpf_y1[k];
+	}
 	
-	for (register int i=CHUNK_SIZE; i>0; i--)
+	for (int i=0; i<CHUNK_SIZE; i++)
 	{
-		y1 += b0 * (*input++);							// y[n-1] + b0*x[n]
-		y1 += a1 * output_sample;						// y[n-1] + b0*x[n] + a1*y[n-1]
-		output_sample = y1;
-		*output++ = output_sample;
+		for (int k=0; k<JOT_LINES; k++)
+		{
+			y1[k] += b0[k]*lines[k] + a1[k]*y1[k];		// y[n-1] + b0*x[n] + a1*y[n-1]
+			lines[k] = y1[k];
+		}
+		lines += JOT_LINES;
 	}
 	
-	this_filter->y1 = y1;								// save state
+	for (int k=0; k<JOT_LINES; k++)
+		this_reverb->lpf_y1[k] = y1[k];					// save state
 }
 
 
-#define BEGIN_ROW(source_signal)						\
-input_ptr = source_signal;						        \
-for(register int i=0; i<CHUNK_SIZE; i++)		                        \
-{										\
-register float	acc = *input_ptr++;
-
-#define	PLUS_ONE(in_ptr)	acc += *in_ptr++;
-#define	MINUS_ONE(in_ptr)	acc -= *in_ptr++;
-
-#define	END_ROW(node)								\
-node[i] = acc;								        \
-}										\
-x0 -= CHUNK_SIZE;								\
-x1 -= CHUNK_SIZE;								\
-x2 -= CHUNK_SIZE;								\
-x3 -= CHUNK_SIZE;								\
-x4 -= CHUNK_SIZE;								\
-x5 -= CHUNK_SIZE;								\
-x6 -= CHUNK_SIZE;								\
-x7 -= CHUNK_SIZE;
+//
+//	sums the early reflection taps for the CHUNK that was just written to a pre delay line.
+//	one pass per tap over contiguous (masked) samples of the big buffer.
+//
+void EarlyReflections(delayBlock* predelay, const int* tap_delay, const float* tap_gain, float* output)
+{
+	float*	buffer = predelay->buffer_base;
+	int		index_mask = predelay->index_mask;
+	int		start = predelay->input_index - CHUNK_SIZE;	// input_index has already moved past this CHUNK
+	int		history = predelay->written - CHUNK_SIZE;	// samples written before this CHUNK, older ones are silent
+	
+	for (int i=0; i<CHUNK_SIZE; i++)
+		output[i] = 0.0;
+	for (int j=0; j<JOT_EARLY_TAPS; j++)
+	{
+		int		index = start - tap_delay[j];
+		float	gain = tap_gain[j];
+		int		first = tap_delay[j] - history;
+		for (int i=first > 0 ? first : 0; i<CHUNK_SIZE; i++)
+			output[i] += gain * buffer[(index + i) & index_mask];
+	}
+}
 
 
 void JotReverb(reverbBlock* this_reverb, float* left_input, float* right_input)
 {
-	Delay(&(this_reverb->left_predelay), left_input);
-	Delay(&(this_reverb->right_predelay), right_input);
-	
-	register float*	x0 = &(this_reverb->LPF0.output[0]);
-	register float*	x1 = &(this_reverb->LPF1.output[0]);
-	register float*	x2 = &(this_reverb->LPF2.output[0]);
-	register float*	x3 = &(this_reverb->LPF3.output[0]);
-	register float*	x4 = &(this_reverb->LPF4.output[0]);
-	register float*	x5 = &(this_reverb->LPF5.output[0]);
-	register float*	x6 = &(this_reverb->LPF6.output[0]);
-	register float*	x7 = &(this_reverb->LPF7.output[0]);
-	
-	register float*	input_ptr = 0;							// needed for macro expansions below
-	
-	BEGIN_ROW(&(this_reverb->left_predelay.output[0]))
-	PLUS_ONE(x0)
-	PLUS_ONE(x1)
-	PLUS_ONE(x2)
-	PLUS_ONE(x3)
-	MINUS_ONE(x4)
-	MINUS_ONE(x5)
-	MINUS_ONE(x6)
-	MINUS_ONE(x7)
-	END_ROW(this_reverb->node0)
-	
-	BEGIN_ROW(&(this_reverb->right_predelay.output[0]))
-	PLUS_ONE(x0)
-	PLUS_ONE(x1)
-	MINUS_ONE(x2)
-	MINUS_ONE(x3)
-	PLUS_ONE(x4)
-	PLUS_ONE(x5)
-	MINUS_ONE(x6)
-	MINUS_ONE(x7)
-	END_ROW(this_reverb->node1)
-	
-	BEGIN_ROW(&(this_reverb->right_predelay.output[0]))
-	PLUS_ONE(x0)
-	PLUS_ONE(x1)
-	MINUS_ONE(x2)
-	MINUS_ONE(x3)
-	MINUS_ONE(x4)
-	MINUS_ONE(x5)
-	PLUS_ONE(x6)
-	PLUS_ONE(x7)
-	END_ROW(this_reverb->node2)
-	
-	BEGIN_ROW(&(this_reverb->left_predelay.output[0]))
-	PLUS_ONE(x0)
-	MINUS_ONE(x1)
-	PLUS_ONE(x2)
-	MINUS_ONE(x3)
-	PLUS_ONE(x4)
-	MINUS_ONE(x5)
-	PLUS_ONE(x6)
-	MINUS_ONE(x7)
-	END_ROW(this_reverb->node3)
-	
-	BEGIN_ROW(&(this_reverb->right_predelay.output[0]))
-	PLUS_ONE(x0)
-	MINUS_ONE(x1)
-	PLUS_ONE(x2)
-	MINUS_ONE(x3)
-	MINUS_ONE(x4)
-	PLUS_ONE(x5)
-	MINUS_ONE(x6)
-	PLUS_ONE(x7)
-	END_ROW(this_reverb->node4)
-	
-	BEGIN_ROW(&(this_reverb->left_predelay.output[0]))
-	PLUS_ONE(x0)
-	MINUS_ONE(x1)
-	MINUS_ONE(x2)
-	PLUS_ONE(x3)
-	PLUS_ONE(x4)
-	MINUS_ONE(x5)
-	MINUS_ONE(x6)
-	PLUS_ONE(x7)
-	END_ROW(this_reverb->node5)
-	
-	BEGIN_ROW(&(this_reverb->left_predelay.output[0]))
-	PLUS_ONE(x0)
-	MINUS_ONE(x1)
-	MINUS_ONE(x2)
-	PLUS_ONE(x3)
-	MINUS_ONE(x4)
-	PLUS_ONE(x5)
-	PLUS_ONE(x6)
-	MINUS_ONE(x7)
-	END_ROW(this_reverb->node6)
-	
-	BEGIN_ROW(&(this_reverb->right_predelay.output[0]))
-	PLUS_ONE(x0)
-	PLUS_ONE(x1)
-	PLUS_ONE(x2)
-	PLUS_ONE(x3)
-	PLUS_ONE(x4)
-	PLUS_ONE(x5)
-	PLUS_ONE(x6)
-	PLUS_ONE(x7)
-	END_ROW(this_reverb->node7)
-    
+	bool	stereo = left_input != right_input;
+	Delay(&(this_reverb->left_predelay), left_input, this_reverb->left_predelay_output, 1);
+	if (stereo)
+		Delay(&(this_reverb->right_predelay), right_input, this_reverb->right_predelay_output, 1);
+	float*	left_pre = this_reverb->left_predelay_output;
+	float*	right_pre = stereo ? this_reverb->right_predelay_output : left_pre;
+	
+	float*	left_early = this_reverb->left_early;
+	float*	right_early = this_reverb->right_early;
+	EarlyReflections(&(this_reverb->left_predelay), this_reverb->left_early_delay, jotLeftEarlyGain, left_early);
+	EarlyReflections(stereo ? &(this_reverb->right_predelay) : &(this_reverb->left_predelay),
+					 this_reverb->right_early_delay, jotRightEarlyGain, right_early);
+	float	early = this_reverb->early_coef;
+	
+	float*	x = this_reverb->lines;							// damped line outputs of the previous CHUNK
+	float*	node = this_reverb->nodes;
+	float	left_state = this_reverb->left_reverb_state;
+	float	right_state = this_reverb->right_reverb_state;
+	float	dry = this_reverb->dry_coef;
+	float	wet0 = this_reverb->wet_coef0*JOT_STEREO_GAIN;
+	float	wet1 = this_reverb->wet_coef1*JOT_STEREO_GAIN;
 	
-	register float*	input = left_input;
-	register float*	output = &(this_reverb->left_output[0]);
-	register float	reverb_output_state = this_reverb->left_reverb_state;
-	for (register int i=CHUNK_SIZE; i>0; i--)
+	for (int i=0; i<CHUNK_SIZE; i++)
 	{
-		register float reverb_output = *(x0++) + *(x2++) + *(x4++) + *(x6++);
-		register float output_acc = this_reverb->dry_coef * (*input++);
-		output_acc += this_reverb->wet_coef0 * reverb_output;
-		output_acc += this_reverb->wet_coef1 * reverb_output_state;
-		*output++ = output_acc;
-		reverb_output_state = reverb_output;
+		// fast Walsh-Hadamard transform of the eight line outputs
+		float	s0 = x[0] + x[1], d0 = x[0] - x[1];
+		float	s1 = x[2] + x[3], d1 = x[2] - x[3];
+		float	s2 = x[4] + x[5], d2 = x[4] - x[5];
+		float	s3 = x[6] + x[7], d3 = x[6] - x[7];
+		float	t0 = s0 + s1, t1 = d0 + d1, t2 = s0 - s1, t3 = d0 - d1;
+		float	t4 = s2 + s3, t5 = d2 + d3, t6 = s2 - s3, t7 = d2 - d3;
+		float	h[JOT_LINES] = { t0 + t4, t1 + t5, t2 + t6, t3 + t7, t0 - t4, t1 - t5, t2 - t6, t3 - t7 };
+		
+		float	l = (left_pre[i] + JOT_EARLY_FEED*left_early[i])*JOT_STEREO_GAIN;
+		float	r = (right_pre[i] + JOT_EARLY_FEED*right_early[i])*JOT_STEREO_GAIN;
+		// feedback rows in the order of the original matrix: Walsh functions 4, 2, 6, 1, 5, 3, 7, 0
+		node[0] = h[4] + jotLeftIn[0]*l + jotRightIn[0]*r;
+		node[1] = h[2] + jotLeftIn[1]*l + jotRightIn[1]*r;
+		node[2] = h[6] + jotLeftIn[2]*l + jotRightIn[2]*r;
+		node[3] = h[1] + jotLeftIn[3]*l + jotRightIn[3]*r;
+		node[4] = h[5] + jotLeftIn[4]*l + jotRightIn[4]*r;
+		node[5] = h[3] + jotLeftIn[5]*l + jotRightIn[5]*r;
+		node[6] = h[7] + jotLeftIn[6]*l + jotRightIn[6]*r;
+		node[7] = h[0] + jotLeftIn[7]*l + jotRightIn[7]*r;
+		
+		float	left_reverb = 0.0;
+		float	right_reverb = 0.0;
+		for (int k=0; k<JOT_LINES; k++)
+		{
+			left_reverb += jotLeftOut[k]*x[k];
+			right_reverb += jotRightOut[k]*x[k];
+		}
+		this_reverb->left_output[i] = dry*left_input[i] + wet0*left_reverb + wet1*left_state + early*left_early[i];
+		this_reverb->right_output[i] = dry*right_input[i] + wet0*right_reverb + wet1*right_state + early*right_early[i];
+		left_state = left_reverb;
+		right_state = right_reverb;
+		
+		x += JOT_LINES;
+		node += JOT_LINES;
 	}
-	this_reverb->left_reverb_state = reverb_output_state;
-	
-	if(left_input != right_input){
-	  input = right_input;
-	  output = &(this_reverb->right_output[0]);
-	  reverb_output_state = this_reverb->right_reverb_state;
-	  for (register int i=CHUNK_SIZE; i>0; i--)
-	    {
-	      register float reverb_output = *(x1++) + *(x3++) + *(x5++) + *(x7++);
-	      register float output_acc = this_reverb->dry_coef * (*input++);
-	      output_acc += this_reverb->wet_coef0 * reverb_output;
-	      output_acc += this_reverb->wet_coef1 * reverb_output_state;
-	      *output++ = output_acc;
-	      reverb_output_state = reverb_output;
-	    }
-	  this_reverb->right_reverb_state = reverb_output_state;
-	}	
-	
-	Delay(&(this_reverb->delay0), this_reverb->node0);
-	Delay(&(this_reverb->delay1), this_reverb->node1);
-	Delay(&(this_reverb->delay2), this_reverb->node2);
-	Delay(&(this_reverb->delay3), this_reverb->node3);
-	Delay(&(this_reverb->delay4), this_reverb->node4);
-	Delay(&(this_reverb->delay5), this_reverb->node5);
-	Delay(&(this_reverb->delay6), this_reverb->node6);
-	Delay(&(this_reverb->delay7), this_reverb->node7);
-	
-	Filter(&(this_reverb->LPF0), &(this_reverb->delay0.output[0]));
-	Filter(&(this_reverb->LPF1), &(this_reverb->delay1.output[0]));
-	Filter(&(this_reverb->LPF2), &(this_reverb->delay2.output[0]));
-	Filter(&(this_reverb->LPF3), &(this_reverb->delay3.output[0]));
-	Filter(&(this_reverb->LPF4), &(this_reverb->delay4.output[0]));
-	Filter(&(this_reverb->LPF5), &(this_reverb->delay5.output[0]));
-	Filter(&(this_reverb->LPF6), &(this_reverb->delay6.output[0]));
-	Filter(&(this_reverb->LPF7), &(this_reverb->delay7.output[0]));
+	this_reverb->left_reverb_state = left_state;
+	this_reverb->right_reverb_state = right_state;
+	
+	for (int n=0; n<JOT_LINES; n++)
+		Delay(&(this_reverb->line[n]), this_reverb->nodes + n, this_reverb->lines + n, JOT_LINES);
+	
+	Filter(this_reverb, this_reverb->lines);
 }
 
 
@@ -689,32 +633,31 @@ public:
     
     void processAudio(AudioBuffer &buffer){
         setParams();
-        int numSamples = buffer.getSize(); // works for numSamples being a multiple of CHUNK_SIZE
-        int nbChannels = buffer.getChannels();
-        // Case Mono
-        if (nbChannels==1){
-            float* buf = buffer.getSamples(0);
-            int i=0;
-            while (i<numSamples+1-CHUNK_SIZE){
-                JotReverb(&theReverbBlock, buf+i,buf+i);
+        int numSamples = buffer.getSize();
+        float* bufL = buffer.getSamples(0);
+        float* bufR = buffer.getChannels() > 1 ? buffer.getSamples(1) : bufL; // the same buffer twice means mono
+        if ((numSamples & (CHUNK_SIZE-1)) == 0){
+            for (int i=0; i<numSamples; i+=CHUNK_SIZE){
+                JotReverb(&theReverbBlock, bufL+i, bufR+i);
                 for (int k=0;k<CHUNK_SIZE;k++){
-                    buf[i+k]=theReverbBlock.left_output[k];
+                    bufR[i+k]=theReverbBlock.right_output[k];
+                    bufL[i+k]=theReverbBlock.left_output[k];
                 }
-                i += CHUNK_SIZE;
             }
-        }
-        // Case Stereo
-        else if (nbChannels==2){
-            float* bufL = buffer.getSamples(0);
-            float* bufR = buffer.getSamples(1);
-            int i=0;
-            while (i<numSamples+1-CHUNK_SIZE){
-                JotReverb(&theReverbBlock, bufL+i,bufR+i);
-                for (int k=0;k<CHUNK_SIZE;k++){
-                    bufL[i+k]=theReverbBlock.left_output[k];
-                    bufR[i+k]=theReverbBlock.right_output[k];
+        }else{
+            // any other block size: collect a CHUNK, process it, and play it back during the next CHUNK
+            reverbBlock* rb = &theReverbBlock;
+            for (int i=0; i<numSamples; i++){
+                int k = rb->fifo_index;
+                rb->left_fifo[k] = bufL[i];
+                rb->right_fifo[k] = bufR[i];
+                bufR[i] = rb->right_output[k];
+                bufL[i] = rb->left_output[k];
+                if (++k == CHUNK_SIZE){
+                    JotReverb(rb, rb->left_fifo, bufR == bufL ? rb->left_fifo : rb->right_fifo);
+                    k = 0;
                 }
-                i += CHUNK_SIZE;
+                rb->fifo_index = k;
             }
         }
     }
@@ -34,10 +34,10 @@
 #define KP_NUM_BUFFER (1<<16)
 #define KP_NOISETYPE_GAUSSIAN 1
 #define KP_NOISETYPE_RANDOM 2
+#define KP_NOISE_SEED 22222 // restarted on every pluck, so that all plucks use the same burst
 
 typedef struct {
   int numSamps; // N
-  float noise[KP_NUM_SAMPLES];  // white noise x(n)
   float pluck[KP_NUM_BUFFER]; // output y(n)
   float amp;
   float duration;
@@ -45,6 +45,7 @@ typedef struct {
   float g; // filter gain/string tension/decay factor
   bool noteOn;
   uint8_t noiseType;
+  uint32_t seed; // noise generator state
 } KarplusData;
 
 class KarplusStrongPatch : public Patch {
@@ -67,6 +68,7 @@ public:
 
     if(isButtonPressed(PUSHBUTTON) && !data.noteOn){
       data.noteOn = true;
+      data.seed = KP_NOISE_SEED;
       pressButton(RED_BUTTON);
     }
 
@@ -82,7 +84,7 @@ public:
 	}else{
 	  // computing the first N samples, y(n) = x(n)
 	  if(data.noiseType == KP_NOISETYPE_GAUSSIAN)
-	    data.pluck[data.phase] = data.noise[data.phase]; // use gaussian white noise
+	    data.pluck[data.phase] = gaussianNoise(); // use gaussian white noise
 	  if(data.noiseType == KP_NOISETYPE_RANDOM)
 	    data.pluck[data.phase] = rand()%100000/100000.;  // use random noise
 	}
@@ -107,37 +109,19 @@ public:
 	data.phase = 0;
 	data.noteOn = false;
 	data.noiseType = KP_NOISETYPE_GAUSSIAN;
-
-	//generate white gaussian noise:
-	// from http://www.musicdsp.org/showone.php?id=168
-
-	/* Generate a new random seed from system time - do this once in your constructor */
-	// srand(time(0));
-
-	/* Setup constants */
-	const static int q = 15;
-	const static float c1 = (1 << q) - 1;
-	const static float c2 = ((int)(c1 / 3)) + 1;
-	const static float c3 = 1.f / c1;
-
-	float max = 0;
-
-	/* random number in range 0 - 1 not including 1 */
-	float random = 0.f;
-
-	for (int i = 0; i < KP_NUM_SAMPLES; i++){
-	  random = ((float)rand() / (float)RAND_MAX);
-	  data.noise[i] = (2.f * ((random * c2) + (random * c2) + (random * c2)) - 3.f * (c2 - 1.f)) * c3;	  
-	  if(fabs(data.noise[i]) > max)
-	    max = fabs(data.noise[i]);
-	}
-
-	for (int i = 0; i < KP_NUM_SAMPLES; i++){
-	  //normalize the gain of our noise
-	  data.noise[i] = data.noise[i] / max;
-	}
-
+	data.seed = KP_NOISE_SEED;
 }
+
+  // white gaussian noise approximation in [-1, 1), the sum of three uniform draws
+  // as in http://www.musicdsp.org/showone.php?id=168, from a linear congruential generator
+  float gaussianNoise(){
+    float sum = 0;
+    for(int k=0; k<3; ++k){
+      data.seed = 12345 + 1103515245 * data.seed;
+      sum += (int32_t)data.seed;
+    }
+    return sum * (4.656612875245797e-10f / 3);
+  }
 };
 
 #endif // __KarplusStrongPatch_hpp__
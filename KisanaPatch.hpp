@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ 
+ 
+ LICENSE:
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+
+/* created by the OWL team 2013 */
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __KisanaPatch_hpp__
+#define __KisanaPatch_hpp__
+
+#include "StompBox.h"
+#include "StringBank.hpp"
+
+/*
+  Native port of Faust/HarpAuto.dsp (Kisana): four pentatonic strings on a
+  StringBank, played by a 15 step loop that records the note knob.
+  Steps and plucks are quantised to the block.
+*/
+#define KISANA_STRINGS 4
+#define KISANA_STEPS 15
+#define KISANA_BPS 360 // loop tempo, in steps per minute
+#define KISANA_KEY 48 // midi key of the first string
+#define KISANA_T60 4.0f // decay time, in seconds
+
+class KisanaPatch : public Patch {
+private:
+  StringBank strings;
+  float* output;
+  float loop[KISANA_STEPS];
+  int step;
+  int stepLength; // in samples
+  int counter;
+  int lastNote; // note knob at the previous block
+  int noteChange; // knob movement since the last step
+  int playing; // note played by the current step
+  float attenuation[KISANA_STRINGS];
+public:
+  KisanaPatch() : step(0), counter(0), lastNote(0), noteChange(0), playing(0) {
+    registerParameter(PARAMETER_A, "Master");
+    registerParameter(PARAMETER_B, "Note");
+    registerParameter(PARAMETER_C, "Timbre");
+    registerParameter(PARAMETER_D, "");
+    static const int degrees[KISANA_STRINGS] = { 0, 2, 4, 7 };
+    float fs = getSampleRate();
+    float maxPeriod = fs / (440.0f * powf(2.0f, (KISANA_KEY - 69) / 12.0f));
+    unsigned int rows = StringBank::getRingSize(maxPeriod);
+    strings.initialise(createMemoryBuffer(1, rows*STRINGBANK_LANES)->getSamples(0), rows);
+    for(int i=0; i<KISANA_STRINGS; ++i){
+      float freq = 440.0f * powf(2.0f, (KISANA_KEY + degrees[i] - 69) / 12.0f);
+      float p = (i+0.5f)/KISANA_STRINGS;
+      attenuation[i] = powf(0.001f, 1.0f/(freq*KISANA_T60));
+      // both pan outputs are summed to mono
+      strings.setString(i, fs / freq, 0, 0, sqrtf(1-p) + sqrtf(p), 0);
+    }
+    memset(loop, 0, sizeof(loop));
+    stepLength = fs * 60 / KISANA_BPS;
+    output = createMemoryBuffer(1, getBlockSize())->getSamples(0);
+  }
+  void processAudio(AudioBuffer &buffer){
+    int size = buffer.getSize();
+    float master = getParameterValue(PARAMETER_A);
+    int note = getParameterValue(PARAMETER_B) * KISANA_STRINGS + 0.5f;
+    float timbre = getParameterValue(PARAMETER_C);
+    for(int i=0; i<KISANA_STRINGS; ++i)
+      strings.setTaps(i, 0.5f*(1+timbre)*attenuation[i], 0.5f*(1-timbre)*attenuation[i]);
+
+    noteChange += abs(note - lastNote);
+    lastNote = note;
+    counter += size;
+    if(counter >= stepLength){
+      counter -= stepLength;
+      step = (step + 1) % KISANA_STEPS;
+      // record the knob if it was moved during the last step, 0 clears the step
+      if(noteChange > 0 || note <= 0)
+	loop[step] = note;
+      noteChange = 0;
+      int next = loop[step];
+      if(next != playing && next > 0)
+	strings.pluck(next-1);
+      playing = next;
+    }
+
+    float* buf = buffer.getSamples(0);
+    strings.process(output, NULL, size, 1.0f);
+    // output = input + master * strings
+    arm_scale_f32(output, master, output, size);
+    arm_add_f32(buf, output, buf, size);
+  }
+};
+
+#endif // __KisanaPatch_hpp__
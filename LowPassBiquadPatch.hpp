@@ -0,0 +1,55 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ 
+ 
+ LICENSE:
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+
+/* Low pass filter from Faust/LowPassFilter.dsp, native version by the OWL team */
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LowPassBiquadPatch_hpp__
+#define __LowPassBiquadPatch_hpp__
+
+#include "StompBox.h"
+#include "RampedBiquad.hpp"
+
+/*
+  Native version of Faust/LowPassFilter.dsp: RBJ low pass with the
+  frequency (100Hz to 10kHz) on B and Q (0.01 to 100) on C.
+*/
+class LowPassBiquadPatch : public Patch {
+private:
+  RampedBiquad filter;
+public:
+  LowPassBiquadPatch(){
+    registerParameter(PARAMETER_A, "");
+    registerParameter(PARAMETER_B, "Freq");
+    registerParameter(PARAMETER_C, "Q");
+  }
+  void processAudio(AudioBuffer &buffer){
+    float freq = 100.0f + 9900.0f*getParameterValue(PARAMETER_B);
+    float q = 0.01f + 99.99f*getParameterValue(PARAMETER_C);
+    filter.setLowPass(freq/getSampleRate(), q);
+    filter.process(buffer.getSamples(0), buffer.getSize());
+  }
+};
+
+#endif // __LowPassBiquadPatch_hpp__
@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ 
+ 
+ LICENSE:
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+
+/* Low shelf from Faust/LowShelf.dsp, native version by the OWL team */
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LowShelfBiquadPatch_hpp__
+#define __LowShelfBiquadPatch_hpp__
+
+#include "StompBox.h"
+#include "RampedBiquad.hpp"
+
+/*
+  Native version of Faust/LowShelf.dsp: RBJ low shelf with the gain
+  (-10dB to +10dB) on A, the frequency (100Hz to 10kHz) on B and Q
+  (0.01 to 100) on C.
+*/
+class LowShelfBiquadPatch : public Patch {
+private:
+  RampedBiquad filter;
+public:
+  LowShelfBiquadPatch(){
+    registerParameter(PARAMETER_A, "Gain");
+    registerParameter(PARAMETER_B, "Freq");
+    registerParameter(PARAMETER_C, "Q");
+  }
+  void processAudio(AudioBuffer &buffer){
+    float gain = -10.0f + 20.0f*getParameterValue(PARAMETER_A);
+    float freq = 100.0f + 9900.0f*getParameterValue(PARAMETER_B);
+    float q = 0.01f + 99.99f*getParameterValue(PARAMETER_C);
+    filter.setLowShelf(freq/getSampleRate(), gain, q);
+    filter.process(buffer.getSamples(0), buffer.getSize());
+  }
+};
+
+#endif // __LowShelfBiquadPatch_hpp__
@@ -0,0 +1,114 @@
+#ifndef __MatrixMixer_hpp__
+#define __MatrixMixer_hpp__
+
+#define MATRIX_MAX_CHANNELS 8
+#define MATRIX_CHUNK 32 // samples mixed per pass, buffered on the stack
+
+static const float matrixRamp[MATRIX_CHUNK] = {
+  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+  16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31
+};
+
+/**
+ * N inputs by M outputs mixing matrix.
+ * New gains are ramped linearly across the next processed block, so gain
+ * changes do not click. Coefficients that are zero at both ends of the
+ * ramp are skipped. Each coefficient is applied with CMSIS block functions
+ * over chunks of MATRIX_CHUNK samples, and the outputs of a chunk are only
+ * written once all its inputs have been read, so processing can be done
+ * in place.
+ */
+class MatrixMixer {
+private:
+  int inputs;
+  int outputs;
+  float gains[MATRIX_MAX_CHANNELS][MATRIX_MAX_CHANNELS]; // [out][in], as applied at the end of the last block
+  float targets[MATRIX_MAX_CHANNELS][MATRIX_MAX_CHANNELS];
+public:
+  MatrixMixer(int in, int out) : inputs(in), outputs(out) {
+    memset(gains, 0, sizeof(gains));
+    memset(targets, 0, sizeof(targets));
+  }
+  int getInputs(){
+    return inputs;
+  }
+  int getOutputs(){
+    return outputs;
+  }
+  /* set the gain from input in to output out, reached at the end of the next block */
+  void setGain(int out, int in, float gain){
+    targets[out][in] = gain;
+  }
+  float getGain(int out, int in){
+    return targets[out][in];
+  }
+  /* jump to the target gains without ramping, e.g. after construction */
+  void reset(){
+    memcpy(gains, targets, sizeof(gains));
+  }
+  /* outputs may be the same buffers as inputs */
+  void process(float** in, float** out, int size){
+    // collect the coefficients that contribute to this block
+    int count = 0;
+    int src[MATRIX_MAX_CHANNELS*MATRIX_MAX_CHANNELS];
+    int dst[MATRIX_MAX_CHANNELS*MATRIX_MAX_CHANNELS];
+    float gain[MATRIX_MAX_CHANNELS*MATRIX_MAX_CHANNELS]; // at the first sample of the block
+    float step[MATRIX_MAX_CHANNELS*MATRIX_MAX_CHANNELS];
+    float scale = 1.0f / size;
+    for(int o=0; o<outputs; ++o){
+      for(int i=0; i<inputs; ++i){
+	if(gains[o][i] != 0.0f || targets[o][i] != 0.0f){
+	  src[count] = i;
+	  dst[count] = o;
+	  step[count] = (targets[o][i] - gains[o][i]) * scale;
+	  gain[count] = gains[o][i] + step[count];
+	  count++;
+	}
+	gains[o][i] = targets[o][i];
+      }
+    }
+    // each coefficient is applied as a run over a chunk of samples; the
+    // outputs are only written once all inputs of the chunk have been read
+    float acc[MATRIX_MAX_CHANNELS][MATRIX_CHUNK];
+    float tmp[MATRIX_CHUNK];
+    bool used[MATRIX_MAX_CHANNELS];
+    for(int n=0; n<size; n+=MATRIX_CHUNK){
+      int len = min(MATRIX_CHUNK, size-n);
+      for(int o=0; o<outputs; ++o)
+	used[o] = false;
+      for(int k=0; k<count; ++k){
+	float* x = in[src[k]]+n;
+	float* y = acc[dst[k]];
+	float* t = used[dst[k]] ? tmp : y;
+	if(step[k] == 0.0f){
+	  arm_scale_f32(x, gain[k], t, len);
+	}else{
+	  // gain[k] + (n+j)*step[k] for the j-th sample of the chunk
+	  arm_scale_f32((float*)matrixRamp, step[k], t, len);
+	  arm_offset_f32(t, gain[k] + n*step[k], t, len);
+	  arm_mult_f32(t, x, t, len);
+	}
+	if(used[dst[k]])
+	  arm_add_f32(y, tmp, y, len);
+	used[dst[k]] = true;
+      }
+      for(int o=0; o<outputs; ++o){
+	if(used[o])
+	  arm_copy_f32(acc[o], out[o]+n, len);
+	else
+	  arm_fill_f32(0.0f, out[o]+n, len);
+      }
+    }
+  }
+  /* mix in place; a buffer with fewer channels than the matrix repeats its
+     last channel, which then ends up holding the last output */
+  void process(AudioBuffer& buffer){
+    float* channels[MATRIX_MAX_CHANNELS];
+    int n = buffer.getChannels();
+    for(int ch=0; ch<MATRIX_MAX_CHANNELS; ++ch)
+      channels[ch] = buffer.getSamples(ch < n ? ch : n-1);
+    process(channels, channels, buffer.getSize());
+  }
+};
+
+#endif // __MatrixMixer_hpp__
@@ -0,0 +1,27 @@
+#ifndef __ParameterSnapshot_hpp__
+#define __ParameterSnapshot_hpp__
+
+#define PARAMETER_SNAPSHOT_SIZE 5 // PARAMETER_A to PARAMETER_E
+
+/**
+ * Copy of the patch parameters taken once at the start of a block.
+ * Inner loops read plain floats instead of calling getParameterValue().
+ */
+class ParameterSnapshot {
+private:
+  float values[PARAMETER_SNAPSHOT_SIZE];
+public:
+  ParameterSnapshot() {
+    for(int i=0; i<PARAMETER_SNAPSHOT_SIZE; ++i)
+      values[i] = 0.0f;
+  }
+  void update(Patch& patch){
+    for(int i=0; i<PARAMETER_SNAPSHOT_SIZE; ++i)
+      values[i] = patch.getParameterValue((PatchParameterId)i);
+  }
+  inline float get(PatchParameterId id){
+    return values[id];
+  }
+};
+
+#endif // __ParameterSnapshot_hpp__
@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ 
+ 
+ LICENSE:
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+
+/* Echo from Faust/Echo.dsp and Faust/StereoEcho.dsp, native version by the OWL team */
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __PingPongEchoPatch_hpp__
+#define __PingPongEchoPatch_hpp__
+
+#include "StompBox.h"
+#include "EchoEngine.hpp"
+
+#define ECHO_MAX_MS 1000.0f // longest delay on the Time knob
+
+/*
+  Native version of the Faust echoes with damping and cross-feed.
+  The delay arena is sized for ECHO_MAX_MS at the current sample rate.
+  A mono input is fed to both lanes and the left output is kept.
+*/
+class PingPongEchoPatch : public Patch {
+private:
+  EchoEngine echo;
+  float samplesPerMs;
+public:
+  PingPongEchoPatch(){
+    registerParameter(PARAMETER_A, "Time");
+    registerParameter(PARAMETER_B, "Feedback");
+    registerParameter(PARAMETER_C, "Damping");
+    registerParameter(PARAMETER_D, "Cross");
+    samplesPerMs = getSampleRate()*0.001f;
+    unsigned int frames = EchoEngine::getRingSize((int)(ECHO_MAX_MS*samplesPerMs) + 1);
+    AudioBuffer* arena = createMemoryBuffer(1, ECHO_LANES*frames);
+    echo.initialise(arena->getSamples(0), frames);
+  }
+  void processAudio(AudioBuffer &buffer){
+    int delay = 1 + (int)(getParameterValue(PARAMETER_A)*ECHO_MAX_MS*samplesPerMs);
+    float* left = buffer.getSamples(0);
+    float* right = buffer.getChannels() > 1 ? buffer.getSamples(1) : left;
+    echo.process(left, right, buffer.getSize(), delay,
+		 getParameterValue(PARAMETER_B),
+		 getParameterValue(PARAMETER_C),
+		 getParameterValue(PARAMETER_D));
+  }
+};
+
+#endif // __PingPongEchoPatch_hpp__
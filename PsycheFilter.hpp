@@ -10,6 +10,7 @@
 #define __PsycheFilterPatch_hpp__
 
 #include "StompBox.h"
+#include "ParameterSnapshot.hpp"
 
 #define PSYF_TWOPI 6.2831853071f
 
@@ -44,6 +45,7 @@ public:
 	}
 
 	void processAudio(AudioBuffer &buffer) {
+		params.update(*this);
 		// apply filter
 		float level = knobs[PARAMETER_D];
 		int size = buffer.getSize();
@@ -86,6 +88,7 @@ public:
 	}
 
 private:
+	ParameterSnapshot params;
 	float knobs[6];
 	float k;
 	float p;
@@ -103,58 +106,58 @@ private:
 	double sampleRate;
 
 	bool parametersChanged() {
-		return getParameterValue(PARAMETER_A) != knobs[PARAMETER_A]
-			|| getParameterValue(PARAMETER_B) != knobs[PARAMETER_B]
-			|| getParameterValue(PARAMETER_C) != knobs[PARAMETER_C]
-			|| getParameterValue(PARAMETER_D) != knobs[PARAMETER_D]
-			|| getParameterValue(PARAMETER_E) != knobs[PARAMETER_E];
+		return params.get(PARAMETER_A) != knobs[PARAMETER_A]
+			|| params.get(PARAMETER_B) != knobs[PARAMETER_B]
+			|| params.get(PARAMETER_C) != knobs[PARAMETER_C]
+			|| params.get(PARAMETER_D) != knobs[PARAMETER_D]
+			|| params.get(PARAMETER_E) != knobs[PARAMETER_E];
 	}
 
 	inline void updateKnobs() {
 		// update knobs
-		float diff = knobs[PARAMETER_A] - getParameterValue(PARAMETER_A);
+		float diff = knobs[PARAMETER_A] - params.get(PARAMETER_A);
 		if (diff >= PSYF_KNOB_STEP) {
 			knobs[PARAMETER_A] -= PSYF_KNOB_STEP;
 		} else if (diff <= -PSYF_KNOB_STEP) {
 			knobs[PARAMETER_A] += PSYF_KNOB_STEP;
 		} else {
-			knobs[PARAMETER_A] = getParameterValue(PARAMETER_A);
+			knobs[PARAMETER_A] = params.get(PARAMETER_A);
 		}
 
-		diff = knobs[PARAMETER_B] - getParameterValue(PARAMETER_B);
+		diff = knobs[PARAMETER_B] - params.get(PARAMETER_B);
 		if (diff >= PSYF_KNOB_STEP) {
 			knobs[PARAMETER_B] -= PSYF_KNOB_STEP;
 		} else if (diff <= -PSYF_KNOB_STEP) {
 			knobs[PARAMETER_B] += PSYF_KNOB_STEP;
 		} else {
-			knobs[PARAMETER_B] = getParameterValue(PARAMETER_B);
+			knobs[PARAMETER_B] = params.get(PARAMETER_B);
 		}
 
-		diff = knobs[PARAMETER_C] - getParameterValue(PARAMETER_C);
+		diff = knobs[PARAMETER_C] - params.get(PARAMETER_C);
 		if (diff >= PSYF_KNOB_STEP) {
 			knobs[PARAMETER_C] -= PSYF_KNOB_STEP;
 		} else if (diff <= -PSYF_KNOB_STEP) {
 			knobs[PARAMETER_C] += PSYF_KNOB_STEP;
 		} else {
-			knobs[PARAMETER_C] = getParameterValue(PARAMETER_C);
+			knobs[PARAMETER_C] = params.get(PARAMETER_C);
 		}
 
-		diff = knobs[PARAMETER_D] - getParameterValue(PARAMETER_D);
+		diff = knobs[PARAMETER_D] - params.get(PARAMETER_D);
 		if (diff >= PSYF_KNOB_STEP) {
 			knobs[PARAMETER_D] -= PSYF_KNOB_STEP;
 		} else if (diff <= -PSYF_KNOB_STEP) {
 			knobs[PARAMETER_D] += PSYF_KNOB_STEP;
 		} else {
-			knobs[PARAMETER_D] = getParameterValue(PARAMETER_D);
+			knobs[PARAMETER_D] = params.get(PARAMETER_D);
 		}
 
-		diff = knobs[PARAMETER_E] - getParameterValue(PARAMETER_E);
+		diff = knobs[PARAMETER_E] - params.get(PARAMETER_E);
 		if (diff >= PSYF_KNOB_STEP) {
 			knobs[PARAMETER_E] -= PSYF_KNOB_STEP;
 		} else if (diff <= -PSYF_KNOB_STEP) {
 			knobs[PARAMETER_E] += PSYF_KNOB_STEP;
 		} else {
-			knobs[PARAMETER_E] = getParameterValue(PARAMETER_E);
+			knobs[PARAMETER_E] = params.get(PARAMETER_E);
 		}
 	}
 
@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ 
+ 
+ LICENSE:
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+
+/* quadrature compander by Katja Vetter, Faust version by Bart Brouns, ported by the OWL team */
+/* see http://www.katjaas.nl/compander/compander.html */
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __QuadratureCompanderPatch_hpp__
+#define __QuadratureCompanderPatch_hpp__
+
+#include "StompBox.h"
+#include "FastMath.hpp"
+
+/*
+  Native version of Faust/Qompander.dsp.
+  The input is split into a quadrature pair by two allpass chains (filter
+  coefficients by Olli Niemitalo), the envelope is the magnitude of the pair
+  and the gain law is sin(pi/2 * factor * env)^exponent / env.
+  Sliders are smoothed, and the time constants and exponent computed, once
+  per block. The gain law uses the polynomial log2/exp2 of FastMath.hpp and
+  the output stays within 1e-5 of the Faust version once the sliders settle.
+*/
+#define QOMP_SMOOTH 0.999f // per sample slider smoothing, as in the Faust code
+
+class QuadratureCompanderPatch : public Patch {
+private:
+  float x1; // input delayed by one sample for the second chain
+  float a[4][2]; // first allpass chain states, y[n-1], y[n-2]
+  float b[4][2]; // second allpass chain states
+  float release; // envelope follower states
+  float envelope;
+  float factor, threshold, attackMs, releaseMs; // smoothed sliders
+  float blockSmooth;
+  double sampleRate;
+public:
+  QuadratureCompanderPatch() : x1(0), release(0), envelope(0),
+			       factor(0), threshold(0), attackMs(0), releaseMs(0) {
+    registerParameter(PARAMETER_A, "Factor");
+    registerParameter(PARAMETER_B, "Threshold");
+    registerParameter(PARAMETER_C, "Attack");
+    registerParameter(PARAMETER_D, "Release");
+    memset(a, 0, sizeof(a));
+    memset(b, 0, sizeof(b));
+    sampleRate = getSampleRate();
+    blockSmooth = powf(QOMP_SMOOTH, getBlockSize());
+  }
+
+  void processAudio(AudioBuffer &buffer){
+    int size = buffer.getSize();
+    float* buf = buffer.getSamples(0);
+
+    // sliders, smoothed at block rate
+    smooth(factor, 0.8f + getParameterValue(PARAMETER_A) * (8.0f - 0.8f));
+    smooth(threshold, -96.0f + getParameterValue(PARAMETER_B) * (-20.0f + 96.0f));
+    smooth(attackMs, 1.0f + getParameterValue(PARAMETER_C) * (20.0f - 1.0f));
+    smooth(releaseMs, 20.0f + getParameterValue(PARAMETER_D) * (1000.0f - 20.0f));
+
+    // control rate terms
+    float att = expf(-1000.0f / (sampleRate * attackMs));
+    float rel = expf(-1000.0f / (sampleRate * releaseMs));
+    float magnitude = powf(10.0f, 0.05f * threshold);
+    float exponent = logf(magnitude) / logf(sinf(M_PI/2 * factor * magnitude));
+    float k = M_PI/2 * factor;
+    float limit = 1.0f / factor;
+
+    // keep filter and follower states in registers for the block
+    float xz = x1;
+    float a00 = a[0][0], a01 = a[0][1], a10 = a[1][0], a11 = a[1][1];
+    float a20 = a[2][0], a21 = a[2][1], a30 = a[3][0], a31 = a[3][1];
+    float b00 = b[0][0], b01 = b[0][1], b10 = b[1][0], b11 = b[1][1];
+    float b20 = b[2][0], b21 = b[2][1], b30 = b[3][0], b31 = b[3][1];
+    float r = release;
+    float env = envelope;
+    for(int i=0; i<size; ++i){
+      float x = buf[i];
+      // first chain
+      float t0 = x + 0.161758f * a01;
+      float t1 = 0.161758f * t0 + 0.733029f * a11 - a01;
+      float t2 = 0.733029f * t1 + 0.94535f * a21 - a11;
+      float t3 = 0.94535f * t2 + 0.990598f * a31 - a21;
+      float re = 0.990598f * t3 - a31;
+      a01 = a00; a00 = t0;
+      a11 = a10; a10 = t1;
+      a21 = a20; a20 = t2;
+      a31 = a30; a30 = t3;
+      // second chain, one sample later
+      float u0 = xz + 0.479401f * b01;
+      float u1 = 0.479401f * u0 + 0.876218f * b11 - b01;
+      float u2 = 0.876218f * u1 + 0.976599f * b21 - b11;
+      float u3 = 0.976599f * u2 + 0.9975f * b31 - b21;
+      float im = 0.9975f * u3 - b31;
+      b01 = b00; b00 = u0;
+      b11 = b10; b10 = u1;
+      b21 = b20; b20 = u2;
+      b31 = b30; b30 = u3;
+      xz = x;
+      // instantaneous amplitude and attack/release follower
+      float mag;
+      arm_sqrt_f32(re*re + im*im, &mag);
+      mag = mag < 0.00001f ? 0.00001f : mag > 100.0f ? 100.0f : mag;
+      r = (mag > r ? mag : r) * rel + mag * (1.0f - rel);
+      env = env * att + r * (1.0f - att);
+      // gain law
+      float s = arm_sin_f32(k * (env < limit ? env : limit));
+      s = s < 0.0000001f ? 0.0000001f : s > 1.0f ? 1.0f : s;
+      buf[i] = 0.7071067811865476f * fastpowf(s, exponent) * (re + im) / env;
+    }
+    x1 = xz;
+    a[0][0] = a00; a[0][1] = a01; a[1][0] = a10; a[1][1] = a11;
+    a[2][0] = a20; a[2][1] = a21; a[3][0] = a30; a[3][1] = a31;
+    b[0][0] = b00; b[0][1] = b01; b[1][0] = b10; b[1][1] = b11;
+    b[2][0] = b20; b[2][1] = b21; b[3][0] = b30; b[3][1] = b31;
+    release = r;
+    envelope = env;
+  }
+
+private:
+  void smooth(float& value, float target){
+    value = target + (value - target) * blockSmooth;
+  }
+};
+
+#endif // __QuadratureCompanderPatch_hpp__
@@ -0,0 +1,96 @@
+#ifndef __RampedBiquad_hpp__
+#define __RampedBiquad_hpp__
+
+#include "FastMath.hpp"
+
+/**
+   Single biquad whose coefficients are designed at control rate.
+   The set* methods redesign only when their arguments change, using the
+   CMSIS sin/cos and the FastMath exp2, and the new coefficients are then
+   ramped linearly across the next block so that sweeps do not click.
+   Blocks with settled coefficients run a plain Direct Form 1 loop.
+   Designs follow the RBJ cookbook, as in the Faust maxmsp.lib.
+*/
+class RampedBiquad {
+private:
+  float b0, b1, b2, a1, a2; // current coefficients, a0 normalised to 1
+  float t0, t1, t2, t3, t4; // target coefficients
+  float x1, x2, y1, y2;
+  float lastFreq, lastQ, lastGain;
+  bool ramping;
+
+  void setTarget(float nb0, float nb1, float nb2, float na1, float na2){
+    t0 = nb0; t1 = nb1; t2 = nb2; t3 = na1; t4 = na2;
+    ramping = true;
+  }
+  bool changed(float fn, float q, float db){
+    if(fn == lastFreq && q == lastQ && db == lastGain)
+      return false;
+    lastFreq = fn;
+    lastQ = q;
+    lastGain = db;
+    return true;
+  }
+public:
+  RampedBiquad() : b0(1), b1(0), b2(0), a1(0), a2(0),
+		   t0(1), t1(0), t2(0), t3(0), t4(0),
+		   x1(0), x2(0), y1(0), y2(0),
+		   lastFreq(-1), lastQ(-1), lastGain(0), ramping(false) {}
+  /* fn is the cutoff as a fraction of the sample rate */
+  void setLowPass(float fn, float q){
+    if(!changed(fn, q, 0))
+      return;
+    float w = 2*M_PI*fn;
+    float c = arm_cos_f32(w);
+    float alpha = 0.5f*arm_sin_f32(w)/max(0.001f, q);
+    float norm = 1.0f/(1.0f + alpha);
+    float b = (1.0f - c)*norm;
+    setTarget(0.5f*b, b, 0.5f*b, -2.0f*c*norm, (1.0f - alpha)*norm);
+  }
+  /* low shelf with the gain in dB */
+  void setLowShelf(float fn, float db, float q){
+    if(!changed(fn, q, db))
+      return;
+    float w = 2*M_PI*fn;
+    float c = arm_cos_f32(w);
+    float A = fastexp2f(db*0.0830482024f); // 10^(db/40)
+    float sqrtA;
+    arm_sqrt_f32(A, &sqrtA);
+    float beta = sqrtA*arm_sin_f32(w)/max(0.001f, q); // 2*sqrt(A)*alpha
+    float norm = 1.0f/((A + 1.0f) + (A - 1.0f)*c + beta);
+    setTarget(A*((A + 1.0f) - (A - 1.0f)*c + beta)*norm,
+	      2.0f*A*((A - 1.0f) - (A + 1.0f)*c)*norm,
+	      A*((A + 1.0f) - (A - 1.0f)*c - beta)*norm,
+	      -2.0f*((A - 1.0f) + (A + 1.0f)*c)*norm,
+	      ((A + 1.0f) + (A - 1.0f)*c - beta)*norm);
+  }
+  void process(float* buf, int size){
+    float c0 = b0, c1 = b1, c2 = b2, c3 = a1, c4 = a2;
+    float s1 = x1, s2 = x2, s3 = y1, s4 = y2;
+    if(ramping){
+      float k = 1.0f/size;
+      float d0 = (t0-c0)*k, d1 = (t1-c1)*k, d2 = (t2-c2)*k, d3 = (t3-c3)*k, d4 = (t4-c4)*k;
+      for(int i=0; i<size; ++i){
+	c0 += d0; c1 += d1; c2 += d2; c3 += d3; c4 += d4;
+	float x = buf[i];
+	float y = c0*x + c1*s1 + c2*s2 - c3*s3 - c4*s4;
+	s2 = s1; s1 = x;
+	s4 = s3; s3 = y;
+	buf[i] = y;
+      }
+      b0 = t0; b1 = t1; b2 = t2; a1 = t3; a2 = t4;
+      ramping = false;
+    }else{
+      for(int i=0; i<size; ++i){
+	float x = buf[i];
+	float y = c0*x + c1*s1 + c2*s2 - c3*s3 - c4*s4;
+	s2 = s1; s1 = x;
+	s4 = s3; s3 = y;
+	buf[i] = y;
+      }
+    }
+    x1 = s1; x2 = s2; y1 = s3; y2 = s4;
+  }
+};
+
+#endif // __RampedBiquad_hpp__
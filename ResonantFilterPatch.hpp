@@ -28,7 +28,7 @@
 #ifndef __ResonantFilterPatch_hpp__
 #define __ResonantFilterPatch_hpp__
 
-#include "SampleBasedPatch.hpp"
+#include "StompBox.h"
 
 /**
 Resonant filter
@@ -54,27 +54,87 @@ buf1 = buf1 + f * (buf0 - buf1);
 out = buf1;
 */
 
-class ResonantFilterPatch : public SampleBasedPatch {
+#define RESONANT_BANDS 6 // filters in the bank
+#define RESONANT_TABLE_SIZE 129 // cutoff table points, one per 1/12.8 octave
+#define RESONANT_MIN_HZ 20.0f
+#define RESONANT_OCTAVES 10.0f // 20Hz to 20kHz
+#define RESONANT_MAX_F 0.99f // keeps the feedback finite
+
+class ResonantFilterPatch : public Patch {
 private:
-  float buf0, buf1;
-  float q, f, fb;
+  float buf0[RESONANT_BANDS], buf1[RESONANT_BANDS];
+  float cutoff[RESONANT_TABLE_SIZE]; // coefficient f over log frequency
+  float gain[RESONANT_BANDS];
 public:
-  ResonantFilterPatch() :buf0(0), buf1(0) {
+  ResonantFilterPatch() {
     registerParameter(PARAMETER_A, "Fc", "Cutoff Frequency");
     registerParameter(PARAMETER_B, "Q", "Resonance");
-    registerParameter(PARAMETER_C, "");
-    registerParameter(PARAMETER_D, "");
+    registerParameter(PARAMETER_C, "Bank");
+    registerParameter(PARAMETER_D, "Spread");
+    memset(buf0, 0, sizeof(buf0));
+    memset(buf1, 0, sizeof(buf1));
+    // one pole coefficient for each cutoff: f = 1 - e^(-2pi fc/fs)
+    float fs = getSampleRate();
+    for(int i=0; i<RESONANT_TABLE_SIZE; ++i){
+      float hz = RESONANT_MIN_HZ * powf(2.0f, RESONANT_OCTAVES * i / (RESONANT_TABLE_SIZE-1));
+      cutoff[i] = min(RESONANT_MAX_F, 1.0f - expf(-2*M_PI*hz/fs));
+    }
+    // higher bands are quieter, like formants
+    for(int k=0; k<RESONANT_BANDS; ++k)
+      gain[k] = 1.0f / sqrtf(k+1);
   }
-  void prepare(){
-    f = getParameterValue(PARAMETER_A);
-    q = getParameterValue(PARAMETER_B);
-    fb = q + q/(1.0 - f);
+  void processAudio(AudioBuffer &buffer){
+    float a = getParameterValue(PARAMETER_A);
+    float q = getParameterValue(PARAMETER_B);
+    bool bank = getParameterValue(PARAMETER_C) > 0.5;
+    float spread = getParameterValue(PARAMETER_D) * 2; // up to two octaves between bands
+    int size = buffer.getSize();
+    float* samples = buffer.getSamples(0); // This Class is Mono (1in, 1out)
+    if(!bank){
+      float f = lookup(a * (RESONANT_TABLE_SIZE-1));
+      float fb = q + q/(1.0 - f);
+      float b0 = buf0[0], b1 = buf1[0];
+      for(int i=0; i<size; ++i){
+	b0 = b0 + f * (samples[i] - b0 + fb * (b0 - b1));
+	b1 = b1 + f * (b0 - b1);
+	samples[i] = b1;
+      }
+      buf0[0] = b0;
+      buf1[0] = b1;
+    }else{
+      // band pass outputs (buf0 - buf1) of a bank of filters spaced by the spread
+      float f[RESONANT_BANDS], fb[RESONANT_BANDS];
+      float step = spread * (RESONANT_TABLE_SIZE-1) / RESONANT_OCTAVES;
+      for(int k=0; k<RESONANT_BANDS; ++k){
+	f[k] = lookup(a * (RESONANT_TABLE_SIZE-1) + k * step);
+	fb[k] = q + q/(1.0 - f[k]);
+      }
+      // bands are updated as lanes on local state
+      float b0[RESONANT_BANDS], b1[RESONANT_BANDS];
+      memcpy(b0, buf0, sizeof(b0));
+      memcpy(b1, buf1, sizeof(b1));
+      for(int i=0; i<size; ++i){
+	float in = samples[i];
+	float out = 0;
+	for(int k=0; k<RESONANT_BANDS; ++k){
+	  b0[k] = b0[k] + f[k] * (in - b0[k] + fb[k] * (b0[k] - b1[k]));
+	  b1[k] = b1[k] + f[k] * (b0[k] - b1[k]);
+	  out += gain[k] * (b0[k] - b1[k]);
+	}
+	samples[i] = out;
+      }
+      memcpy(buf0, b0, sizeof(b0));
+      memcpy(buf1, b1, sizeof(b1));
+    }
   }
-  float processSample(float sample){
-    //for each sample...
-    buf0 = buf0 + f * (sample - buf0 + fb * (buf0 - buf1));
-    buf1 = buf1 + f * (buf0 - buf1);
-    return buf1;
+private:
+  /* interpolated coefficient at a fractional table position */
+  float lookup(float pos){
+    if(pos >= RESONANT_TABLE_SIZE-1)
+      return cutoff[RESONANT_TABLE_SIZE-1];
+    int i = (int)pos;
+    float frac = pos - i;
+    return cutoff[i] + frac * (cutoff[i+1] - cutoff[i]);
   }
 };
 
@@ -40,6 +40,7 @@ class ReverseReverbPatch : public Patch
 private:
 
 	int reverb_index, reverse_cnt, reverb_time;
+	int written;	//high-water mark: the first and the last 'written' samples of reverb_buffer hold data
 	char reverse_flag;
 //	float reverse_storage[reverb_buf_length], reverse_current[reverb_buf_length];
 	float reverb_buffer[reverb_buf_length];
@@ -54,7 +55,7 @@ public:
 	reverb_index = 0;
 	reverse_flag = 0;
 	reverse_cnt = 0;
-	memset(reverb_buffer, 0, sizeof(reverb_buffer));	//initialize reverb buffer
+	written = 0;		//reverb buffer is cleared lazily, samples past the high-water mark read as 0
   }
   
   
@@ -82,12 +83,15 @@ public:
 		
 		for(int i=0; i<size; i++)
 		{		
-			reverb_buffer[reverb_buf_length-1-i-reverb_index*size] = reverb_buffer[i+reverb_index*size];	//load reverse into end of buffer
-			reverb_buffer[i+reverb_index*size] = buf[i];	//load number of samples into the reverse buffer equal to size of audio buffer
+			int front = i+reverb_index*size;
+			reverb_buffer[reverb_buf_length-1-front] = front < written ? reverb_buffer[front] : 0;	//load reverse into end of buffer
+			reverb_buffer[front] = buf[i];	//load number of samples into the reverse buffer equal to size of audio buffer
+			if(front >= written) written = front+1;
 
 			if (reverse_flag == 1)
 			{
-				buf[i] = level*((1-wet)*buf[i]+wet*reverb_buffer[reverb_buf_length-1-reverse_cnt]*abs(reverse_cnt-reverb_time)*reverse_cnt/reverb_time/200);
+				float reversed = reverse_cnt < written ? reverb_buffer[reverb_buf_length-1-reverse_cnt] : 0;
+				buf[i] = level*((1-wet)*buf[i]+wet*reversed*abs(reverse_cnt-reverb_time)*reverse_cnt/reverb_time/200);
 				reverse_cnt++;
 				if(reverse_cnt==reverb_time)
 				{
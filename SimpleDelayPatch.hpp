@@ -35,35 +35,84 @@
 
 class SimpleDelayPatch : public Patch {
 private:
-  CircularBuffer delayBuffer;
+  CircularBuffer delayBuffer[2];
   int delay;
+  float* ramp; // crossfade from the old to the new delay time
+  float* faded; // scratch for the old delay time
+  float* wet[2];
+  float* feed[2];
 public:
   SimpleDelayPatch() : delay(0)
   {
     registerParameter(PARAMETER_A, "Delay");
     registerParameter(PARAMETER_B, "Feedback");
-    registerParameter(PARAMETER_C, "");
+    registerParameter(PARAMETER_C, "Ping-Pong");
     registerParameter(PARAMETER_D, "Dry/Wet");
-    AudioBuffer* buffer = createMemoryBuffer(1, REQUEST_BUFFER_SIZE);
-    delayBuffer.initialise(buffer->getSamples(0), buffer->getSize());
+    AudioBuffer* buffer = createMemoryBuffer(2, REQUEST_BUFFER_SIZE);
+    delayBuffer[0].initialise(buffer->getSamples(0), buffer->getSize());
+    delayBuffer[1].initialise(buffer->getSamples(1), buffer->getSize());
+    int size = getBlockSize();
+    AudioBuffer* scratch = createMemoryBuffer(6, size);
+    ramp = scratch->getSamples(0);
+    faded = scratch->getSamples(1);
+    wet[0] = scratch->getSamples(2);
+    wet[1] = scratch->getSamples(3);
+    feed[0] = scratch->getSamples(4);
+    feed[1] = scratch->getSamples(5);
+    for(int n = 0; n < size; n++)
+      ramp[n] = (float)n / size;
   }
   void processAudio(AudioBuffer &buffer)
   {
     float delayTime, feedback, dryWet;
     delayTime = getParameterValue(PARAMETER_A);
     feedback  = getParameterValue(PARAMETER_B);
+    bool pingPong = getParameterValue(PARAMETER_C) > 0.5;
     dryWet    = getParameterValue(PARAMETER_D);
     
-    int32_t newDelay;
-    newDelay = delayTime * (delayBuffer.getSize()-1);
-      
-    float* x = buffer.getSamples(0);
     int size = buffer.getSize();
-    for (int n = 0; n < size; n++)
-    {
-      x[n] = (delayBuffer.read(delay)*(size-1-n) + delayBuffer.read(newDelay)*n)*dryWet/size + (1.f - 0.75*dryWet) * x[n];  // crossfade for wet/dry balance
-      delayBuffer.write(feedback * x[n]);
+    int channels = min(buffer.getChannels(), 2);
+    int32_t newDelay;
+    newDelay = delayTime * (delayBuffer[0].getSize()-1);
+    // whole blocks are read before they are written back, so the delay is at least one block
+    if(newDelay < size)
+      newDelay = size;
+    if(delay < size)
+      delay = newDelay;
+
+    // read contiguous spans at the old and new delay times and crossfade them
+    for(int ch = 0; ch < channels; ch++){
+      delayBuffer[ch].read(faded, size, delay);
+      delayBuffer[ch].read(wet[ch], size, newDelay);
+      arm_sub_f32(wet[ch], faded, wet[ch], size);
+      arm_mult_f32(wet[ch], ramp, wet[ch], size);
+      arm_add_f32(wet[ch], faded, wet[ch], size);
+    }
+
+    float dry = 1.f - 0.75*dryWet;
+    if(channels > 1 && pingPong){
+      // the input enters on the left and the repeats bounce between the channels
+      float* left = buffer.getSamples(0);
+      float* right = buffer.getSamples(1);
+      for (int n = 0; n < size; n++){
+        float wetL = wet[0][n];
+        float wetR = wet[1][n];
+        feed[0][n] = feedback * ((left[n] + right[n]) * 0.5f + wetR);
+        feed[1][n] = feedback * wetL;
+        left[n] = wetL*dryWet + dry*left[n];
+        right[n] = wetR*dryWet + dry*right[n];
+      }
+    }else{
+      for(int ch = 0; ch < channels; ch++){
+        float* x = buffer.getSamples(ch);
+        for (int n = 0; n < size; n++){
+          x[n] = wet[ch][n]*dryWet + dry*x[n];
+          feed[ch][n] = feedback * x[n];
+        }
+      }
     }
+    for(int ch = 0; ch < channels; ch++)
+      delayBuffer[ch].write(feed[ch], size);
     delay=newDelay;
   }
 };
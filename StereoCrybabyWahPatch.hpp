@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ 
+ 
+ LICENSE:
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ 
+ */
+
+
+/* Stereo crybaby wah from the Faust effect.lib, native version by the OWL team */
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __StereoCrybabyWahPatch_hpp__
+#define __StereoCrybabyWahPatch_hpp__
+
+#include "StompBox.h"
+#include "WahEngine.hpp"
+
+/*
+  Native version of Faust/StereoWah.dsp: pedal position on A, dry/wet on B.
+  Both channels run through the same coefficients as two lanes of one filter.
+*/
+class StereoCrybabyWahPatch : public Patch {
+private:
+  WahEngine wah;
+public:
+  StereoCrybabyWahPatch(){
+    registerParameter(PARAMETER_A, "Wah");
+    registerParameter(PARAMETER_B, "Dry/Wet");
+    wah.setSampleRate(getSampleRate());
+  }
+  void processAudio(AudioBuffer &buffer){
+    float* samples[WAH_LANES];
+    int lanes = min(buffer.getChannels(), WAH_LANES);
+    for(int ch=0; ch<lanes; ++ch)
+      samples[ch] = buffer.getSamples(ch);
+    wah.process(samples, lanes, getParameterValue(PARAMETER_A), buffer.getSize(),
+		getParameterValue(PARAMETER_B));
+  }
+};
+
+#endif // __StereoCrybabyWahPatch_hpp__
@@ -30,37 +30,37 @@
 #define __StereoGainPatch_h__
 
 #include "StompBox.h"
+#include "MatrixMixer.hpp"
 
 class StereoGainPatch : public Patch {
+private:
+  MatrixMixer stereo;
+  MatrixMixer mono;
 public:
-  StereoGainPatch(){
+  StereoGainPatch() : stereo(2, 2), mono(1, 1) {
     registerParameter(PARAMETER_A, "Left");
     registerParameter(PARAMETER_B, "Right");
     registerParameter(PARAMETER_C, "");
     registerParameter(PARAMETER_D, "");
+    setGains();
+    stereo.reset(); // start at the knob positions instead of ramping up from silence
+    mono.reset();
+  }
+
+  void setGains(){
+    float gainL = getParameterValue(PARAMETER_A)*2;
+    float gainR = getParameterValue(PARAMETER_B)*2;
+    stereo.setGain(0, 0, gainL);
+    stereo.setGain(1, 1, gainR);
+    mono.setGain(0, 0, gainL);
   }
 
   void processAudio(AudioBuffer &buffer){
-    if(buffer.getChannels() > 1){
-      // stereo gain
-      float gainL = getParameterValue(PARAMETER_A)*2;
-      float gainR = getParameterValue(PARAMETER_B)*2;
-      int size = buffer.getSize();
-      float* left = buffer.getSamples(0);
-      float* right = buffer.getSamples(1);
-      for(int i=0; i<size; ++i){
-	left[i] = gainL*left[i];
-	right[i] = gainR*right[i];
-      }      
-    }else{
-      // mono gain
-      float gain = getParameterValue(PARAMETER_A)*2;
-      int size = buffer.getSize();
-      float* samples = buffer.getSamples(0);
-      for(int i=0; i<size; ++i){
-	samples[i] = gain*samples[i];
-      }      
-    }
+    setGains();
+    if(buffer.getChannels() > 1)
+      stereo.process(buffer);
+    else
+      mono.process(buffer);
   }
 };
 
@@ -29,31 +29,30 @@
 #define __StereoMixerPatch_h__
 
 #include "StompBox.h"
+#include "MatrixMixer.hpp"
 
 class StereoMixerPatch : public Patch {
+private:
+  MatrixMixer mixer;
 public:
-  StereoMixerPatch(){
+  StereoMixerPatch() : mixer(2, 2) {
     registerParameter(PARAMETER_A, "LL");
     registerParameter(PARAMETER_B, "LR");
     registerParameter(PARAMETER_C, "RL");
     registerParameter(PARAMETER_D, "RR");
+    setGains();
+    mixer.reset(); // start at the knob positions instead of ramping up from silence
+  }
+  void setGains(){
+    mixer.setGain(0, 0, getParameterValue(PARAMETER_A));
+    mixer.setGain(0, 1, getParameterValue(PARAMETER_B));
+    mixer.setGain(1, 0, getParameterValue(PARAMETER_C));
+    mixer.setGain(1, 1, getParameterValue(PARAMETER_D));
   }
   void processAudio(AudioBuffer &buffer){
 //     assert_param(buffer.getChannels() > 1);
-    float gainLL = getParameterValue(PARAMETER_A);
-    float gainLR = getParameterValue(PARAMETER_B);
-    float gainRL = getParameterValue(PARAMETER_C);
-    float gainRR = getParameterValue(PARAMETER_D);
-    int size = buffer.getSize();
-    float* left = buffer.getSamples(0);
-    float* right = buffer.getChannels() > 1 ? buffer.getSamples(1) : left;
-    float l, r;
-    for(int i=0; i<size; ++i){
-      l = gainLL*left[i] + gainLR*right[i];
-      r = gainRL*left[i] + gainRR*right[i];
-      left[i] = l;
-      right[i] = r;
-    }
+    setGains();
+    mixer.process(buffer);
   }
 };
 
@@ -0,0 +1,105 @@
+#ifndef __StringBank_hpp__
+#define __StringBank_hpp__
+
+/* Number of strings processed side by side. Inactive lanes are silent. */
+#define STRINGBANK_LANES 8
+
+/**
+   Bank of Karplus-Strong strings updated as parallel lanes.
+   All strings share one interleaved delay ring: sample n of every string is
+   stored in the same row, ring[(n & mask)*STRINGBANK_LANES + lane], so each
+   sample writes a single contiguous row and the per-string loops have a fixed
+   trip count that the compiler can unroll or vectorise.
+   Each string is y[n] = x[n-(d-1)] with x[n] = b0*y[n-1] + b1*y[n-2] + excitation,
+   the excitation being a noise burst of d samples started by pluck().
+*/
+class StringBank {
+private:
+  float* ring;
+  unsigned int mask; // ring rows - 1, power of two
+  unsigned int writeIndex;
+  int delay[STRINGBANK_LANES]; // read offset d-1, in samples
+  int burst[STRINGBANK_LANES]; // remaining samples of excitation
+  int length[STRINGBANK_LANES]; // excitation length
+  float b0[STRINGBANK_LANES];
+  float b1[STRINGBANK_LANES];
+  float y1[STRINGBANK_LANES];
+  float y2[STRINGBANK_LANES];
+  float gainL[STRINGBANK_LANES];
+  float gainR[STRINGBANK_LANES];
+  uint32_t seed; // unsigned so that the generator wraps instead of overflowing
+public:
+  StringBank() : ring(NULL), mask(0), writeIndex(0), seed(0) {
+    memset(delay, 0, sizeof(delay));
+    memset(burst, 0, sizeof(burst));
+    memset(length, 0, sizeof(length));
+    memset(b0, 0, sizeof(b0));
+    memset(b1, 0, sizeof(b1));
+    memset(y1, 0, sizeof(y1));
+    memset(y2, 0, sizeof(y2));
+    memset(gainL, 0, sizeof(gainL));
+    memset(gainR, 0, sizeof(gainR));
+  }
+  /* the buffer must hold rows*STRINGBANK_LANES floats, rows a power of two */
+  void initialise(float* buf, unsigned int rows){
+    ring = buf;
+    mask = rows-1;
+    writeIndex = 0;
+    memset(ring, 0, rows*STRINGBANK_LANES*sizeof(float));
+  }
+  /* number of ring rows needed for a string of the given period, in samples */
+  static unsigned int getRingSize(float maxPeriod){
+    unsigned int rows = 1;
+    while(rows < maxPeriod + 1)
+      rows <<= 1;
+    return rows;
+  }
+  /* set string period (in samples), loop filter taps and output gains */
+  void setString(int lane, float period, float tap0, float tap1, float left, float right){
+    int d = (int)period;
+    if(d < 2)
+      d = 2;
+    if(d > (int)mask + 1)
+      d = mask + 1;
+    delay[lane] = d-1;
+    length[lane] = d;
+    b0[lane] = tap0;
+    b1[lane] = tap1;
+    gainL[lane] = left;
+    gainR[lane] = right;
+  }
+  void setTaps(int lane, float tap0, float tap1){
+    b0[lane] = tap0;
+    b1[lane] = tap1;
+  }
+  void pluck(int lane){
+    burst[lane] = length[lane];
+  }
+  /* render the strings, excited with noise at the given level; right may be NULL for mono */
+  void process(float* left, float* right, int size, float level){
+    float amp = level * 4.656612875245797e-10f; // noise scaling from the Faust harp
+    for(int i=0; i<size; ++i){
+      seed = 12345 + 1103515245 * seed;
+      float noise = amp * (int32_t)seed; // signed, as in the Faust harp
+      float* row = ring + (writeIndex & mask)*STRINGBANK_LANES;
+      float outL = 0;
+      float outR = 0;
+      for(int k=0; k<STRINGBANK_LANES; ++k){
+	float y = ring[((writeIndex - delay[k]) & mask)*STRINGBANK_LANES + k];
+	float excite = burst[k] > 0 ? noise : 0.0f;
+	burst[k] -= burst[k] > 0;
+	row[k] = b0[k]*y1[k] + b1[k]*y2[k] + excite;
+	y2[k] = y1[k];
+	y1[k] = y;
+	outL += gainL[k]*y;
+	outR += gainR[k]*y;
+      }
+      left[i] = outL;
+      if(right != NULL)
+	right[i] = outR;
+      writeIndex++;
+    }
+  }
+};
+
+#endif // __StringBank_hpp__
@@ -7,6 +7,7 @@
 #define __TremoloPatch_hpp__
 
 #include "StompBox.h"
+#include "ParameterSnapshot.hpp"
 
 #define TREM_TWOPI 6.2831853071f
 #define TREM_HALFPI	1.5707963268f
@@ -36,6 +37,7 @@ public:
 	}
 
 	void processAudio(AudioBuffer &buffer) {
+		params.update(*this);
 		float level = 0.0f;
 		// apply effect
 		int size = buffer.getSize();
@@ -71,6 +73,7 @@ public:
 	}
 
 private:
+	ParameterSnapshot params;
 	float knobs[6];
 	float speed;
 	float depth;
@@ -90,48 +93,48 @@ private:
 	double sampleRate;
 
 	inline bool parametersChanged() {
-		return getParameterValue(PARAMETER_A) != knobs[PARAMETER_A]
-			|| getParameterValue(PARAMETER_B) != knobs[PARAMETER_B]
-			|| getParameterValue(PARAMETER_C) != knobs[PARAMETER_C]
-			|| getParameterValue(PARAMETER_D) != knobs[PARAMETER_D];
+		return params.get(PARAMETER_A) != knobs[PARAMETER_A]
+			|| params.get(PARAMETER_B) != knobs[PARAMETER_B]
+			|| params.get(PARAMETER_C) != knobs[PARAMETER_C]
+			|| params.get(PARAMETER_D) != knobs[PARAMETER_D];
 	}
 
 	inline void updateKnobs() {
 		// update knobs
-		float diff = knobs[PARAMETER_A] - getParameterValue(PARAMETER_A);
+		float diff = knobs[PARAMETER_A] - params.get(PARAMETER_A);
 		if (diff >= TREM_KNOB_STEP) {
 			knobs[PARAMETER_A] -= TREM_KNOB_STEP;
 		} else if (diff <= -TREM_KNOB_STEP) {
 			knobs[PARAMETER_A] += TREM_KNOB_STEP;
 		} else {
-			knobs[PARAMETER_A] = getParameterValue(PARAMETER_A);
+			knobs[PARAMETER_A] = params.get(PARAMETER_A);
 		}
 
-		diff = knobs[PARAMETER_B] - getParameterValue(PARAMETER_B);
+		diff = knobs[PARAMETER_B] - params.get(PARAMETER_B);
 		if (diff >= TREM_KNOB_STEP) {
 			knobs[PARAMETER_B] -= TREM_KNOB_STEP;
 		} else if (diff <= -TREM_KNOB_STEP) {
 			knobs[PARAMETER_B] += TREM_KNOB_STEP;
 		} else {
-			knobs[PARAMETER_B] = getParameterValue(PARAMETER_B);
+			knobs[PARAMETER_B] = params.get(PARAMETER_B);
 		}
 
-		diff = knobs[PARAMETER_C] - getParameterValue(PARAMETER_C);
+		diff = knobs[PARAMETER_C] - params.get(PARAMETER_C);
 		if (diff >= TREM_KNOB_STEP) {
 			knobs[PARAMETER_C] -= TREM_KNOB_STEP;
 		} else if (diff <= -TREM_KNOB_STEP) {
 			knobs[PARAMETER_C] += TREM_KNOB_STEP;
 		} else {
-			knobs[PARAMETER_C] = getParameterValue(PARAMETER_C);
+			knobs[PARAMETER_C] = params.get(PARAMETER_C);
 		}
 
-		diff = knobs[PARAMETER_D] - getParameterValue(PARAMETER_D);
+		diff = knobs[PARAMETER_D] - params.get(PARAMETER_D);
 		if (diff >= TREM_KNOB_STEP) {
 			knobs[PARAMETER_D] -= TREM_KNOB_STEP;
 		} else if (diff <= -TREM_KNOB_STEP) {
 			knobs[PARAMETER_D] += TREM_KNOB_STEP;
 		} else {
-			knobs[PARAMETER_D] = getParameterValue(PARAMETER_D);
+			knobs[PARAMETER_D] = params.get(PARAMETER_D);
 		}
 	}
 
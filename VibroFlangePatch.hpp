@@ -61,6 +61,7 @@ public:
 	BaseOscillator() {
 		setSampleRate(44100);
 		frequency = 440;
+		phase = 0;
 	}
 
 	void setSampleRate(float sampleRate) {
@@ -138,6 +139,16 @@ public:
 	float getSampleForPhase() {
 		return sin(phase);
 	}
+
+	// render a block of samples in one go, without the virtual call per sample
+	void getSamples(float* out, int size) {
+		float inc = frequency*TWO_PI_BY_SAMPLERATE;
+		for(int i = 0; i < size; i++) {
+			phase += inc;
+			if(phase>=TWOPI) phase -= TWOPI;
+			out[i] = arm_sin_f32(phase);
+		}
+	}
 };
 
 
@@ -147,27 +158,30 @@ public:
 
 
 
+// length of the delay ring, must be a power of two
+#define VIBRO_DELAY 256
+
 class VibroFlangePatch: public Patch {
 public:
 	
-	float buffer[8192];
-	int inPos;
-	int delay;
+	float* buffer;
+	float* modulation; // per block LFO, in samples of delay
+	unsigned int inPos;
 	float depth;
 
-	SinOscillator *lfo;
+	SinOscillator lfo;
 
 	
 	VibroFlangePatch() {
-		lfo = new SinOscillator();
-		lfo->frequency = 0.5;
+		lfo.setSampleRate(getSampleRate());
+		lfo.frequency = 0.5;
 		depth = 0;
 		inPos = 0;
 
-		delay = 256;
-
-		memset(buffer, 0, 8192*4);
-		
+		AudioBuffer* delayBuffer = createMemoryBuffer(1, VIBRO_DELAY);
+		delayBuffer->clear();
+		buffer = delayBuffer->getSamples(0);
+		modulation = createMemoryBuffer(1, getBlockSize())->getSamples(0);
 
 		registerParameter(PARAMETER_A, "Speed");
 		registerParameter(PARAMETER_B, "Depth");
@@ -186,27 +200,24 @@ public:
 
 
 		depth = getParameterValue(PARAMETER_B);
-		lfo->frequency =  10 * getParameterValue(PARAMETER_A);
+		lfo.frequency =  10 * getParameterValue(PARAMETER_A);
 		float mix = getParameterValue(PARAMETER_C)*0.5;
 		float feedback = getParameterValue(PARAMETER_D)*0.99;
 
+		lfo.getSamples(modulation, size);
+		arm_scale_f32(modulation, depth*VIBRO_DELAY*0.45, modulation, size);
+
+		const unsigned int mask = VIBRO_DELAY-1;
 		for(int i = 0; i < size; i++) {
 
 			float in = y[i];
-			inPos++;
-			inPos %= delay;
-			float fOutPos = inPos - delay / 2 + depth*delay*0.45*lfo->getSample();
-			
-			if(fOutPos<0) fOutPos += delay;
-			
-			
-			
-			float frac = fOutPos - (int)fOutPos;
-			int nextPos = 1+(int)fOutPos;
-			nextPos %= delay;
-			float out = buffer[(int)fOutPos] * (1.f-frac) + buffer[nextPos] * frac;
-			
-			
+			inPos = (inPos + 1) & mask;
+			// read half the ring behind the write head, offset by the LFO;
+			// the LFO swing is less than half the ring so the position stays positive
+			float fOutPos = inPos + VIBRO_DELAY / 2 + modulation[i];
+			unsigned int pos = (unsigned int)fOutPos;
+			float frac = fOutPos - pos;
+			float out = buffer[pos & mask] * (1.f-frac) + buffer[(pos+1) & mask] * frac;
 
 			y[i] = out*(1-mix) + in*mix;
 			buffer[inPos] = in + y[i]*feedback;
@@ -214,7 +225,3 @@ public:
 		}
 	}
 };
-
-
-
-
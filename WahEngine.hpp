@@ -0,0 +1,114 @@
+#ifndef __WahEngine_hpp__
+#define __WahEngine_hpp__
+
+#define WAH_TABLE_SIZE 65 // coefficient table points over the pedal range 0..1
+#define WAH_LANES 2 // channels filtered side by side with shared coefficients
+#define WAH_SMOOTH 0.999f // per sample coefficient smoothing, as in effect.lib
+
+/**
+   Crybaby wah resonator from the Faust effect.lib, with the pedal position to
+   coefficient mapping taken from a table instead of three powf and a cosf.
+   For position w the resonator is
+     y[n] = gain*x[n] - a1*y[n-1] - a2*y[n-2],  out[n] = y[n] - y[n-1]
+   with a1 = -2*r*cos(2*pi*450*2^(2.3w)/fs), a2 = r^2, gain = 0.1*4^w and
+   r = 1 - pi*450*2^(2.3w)/(fs*2^(3-2w)).
+   The table is built once per sample rate and linearly interpolated.
+*/
+class WahEngine {
+private:
+  float a1Table[WAH_TABLE_SIZE];
+  float a2Table[WAH_TABLE_SIZE];
+  float gainTable[WAH_TABLE_SIZE];
+  float a1, a2, gain; // smoothed coefficients
+  float y1[WAH_LANES];
+  float y2[WAH_LANES];
+
+  inline void lookup(float position, float& ta1, float& ta2, float& tgain){
+    float index = position*(WAH_TABLE_SIZE-1);
+    if(index < 0.0f)
+      index = 0.0f;
+    else if(index > WAH_TABLE_SIZE-1.001f)
+      index = WAH_TABLE_SIZE-1.001f;
+    int i = (int)index;
+    float frac = index - i;
+    ta1 = a1Table[i] + frac*(a1Table[i+1] - a1Table[i]);
+    ta2 = a2Table[i] + frac*(a2Table[i+1] - a2Table[i]);
+    tgain = gainTable[i] + frac*(gainTable[i+1] - gainTable[i]);
+  }
+public:
+  WahEngine() : a1(0), a2(0), gain(0) {
+    memset(y1, 0, sizeof(y1));
+    memset(y2, 0, sizeof(y2));
+    setSampleRate(48000);
+  }
+  void setSampleRate(float sr){
+    for(int i=0; i<WAH_TABLE_SIZE; ++i){
+      float w = (float)i/(WAH_TABLE_SIZE-1);
+      float g = powf(2.0f, 2.3f*w);
+      float r = 1.0f - (float)M_PI*450.0f*g/(sr*powf(2.0f, 1.0f + 2.0f*(1.0f - w)));
+      a1Table[i] = -2.0f*r*cosf(2.0f*(float)M_PI*450.0f*g/sr);
+      a2Table[i] = r*r;
+      gainTable[i] = 0.1f*powf(4.0f, w);
+    }
+  }
+  /* filter lanes channels in place at a fixed pedal position, mixing wet with dry */
+  void process(float** samples, int lanes, float position, int size, float wet = 1.0f){
+    float ta1, ta2, tgain;
+    lookup(position, ta1, ta2, tgain);
+    float dry = 1.0f - wet;
+    float c1 = a1, c2 = a2, cg = gain;
+    float s1[WAH_LANES], s2[WAH_LANES];
+    for(int k=0; k<WAH_LANES; ++k){
+      s1[k] = y1[k];
+      s2[k] = y2[k];
+    }
+    for(int i=0; i<size; ++i){
+      c1 = ta1 + WAH_SMOOTH*(c1 - ta1);
+      c2 = ta2 + WAH_SMOOTH*(c2 - ta2);
+      cg = tgain + WAH_SMOOTH*(cg - tgain);
+      for(int k=0; k<lanes; ++k){
+	float x = samples[k][i];
+	float y = cg*x - c1*s1[k] - c2*s2[k];
+	samples[k][i] = dry*x + wet*(y - s1[k]);
+	s2[k] = s1[k];
+	s1[k] = y;
+      }
+    }
+    a1 = c1; a2 = c2; gain = cg;
+    for(int k=0; k<WAH_LANES; ++k){
+      y1[k] = s1[k];
+      y2[k] = s2[k];
+    }
+  }
+  /* as above, with a pedal position for every sample */
+  void process(float** samples, int lanes, const float* position, int size, float wet = 1.0f){
+    float ta1, ta2, tgain;
+    float dry = 1.0f - wet;
+    float c1 = a1, c2 = a2, cg = gain;
+    float s1[WAH_LANES], s2[WAH_LANES];
+    for(int k=0; k<WAH_LANES; ++k){
+      s1[k] = y1[k];
+      s2[k] = y2[k];
+    }
+    for(int i=0; i<size; ++i){
+      lookup(position[i], ta1, ta2, tgain);
+      c1 = ta1 + WAH_SMOOTH*(c1 - ta1);
+      c2 = ta2 + WAH_SMOOTH*(c2 - ta2);
+      cg = tgain + WAH_SMOOTH*(cg - tgain);
+      for(int k=0; k<lanes; ++k){
+	float x = samples[k][i];
+	float y = cg*x - c1*s1[k] - c2*s2[k];
+	samples[k][i] = dry*x + wet*(y - s1[k]);
+	s2[k] = s1[k];
+	s1[k] = y;
+      }
+    }
+    a1 = c1; a2 = c2; gain = cg;
+    for(int k=0; k<WAH_LANES; ++k){
+      y1[k] = s1[k];
+      y2[k] = s2[k];
+    }
+  }
+};
+
+#endif // __WahEngine_hpp__
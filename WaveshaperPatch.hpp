@@ -30,12 +30,15 @@
 #define __WaveshaperPatch_hpp__
 
 #include "StompBox.h"
+#include "ParameterSnapshot.hpp"
 
 #ifdef _MSC_VER
 #define lround roundFloatToInt
 #endif
 
 class WaveshaperPatch : public Patch {
+private:
+  ParameterSnapshot params;
 public:
   WaveshaperPatch(){
     registerParameter(PARAMETER_A, "Drive");
@@ -44,20 +47,21 @@ public:
     registerParameter(PARAMETER_D, "");
   }
   void processAudio(AudioBuffer& buffer){
-    float drive = 1+ getParameterValue(PARAMETER_A) * 30 ; // get input drive value
-    float gain = getParameterValue(PARAMETER_C) / 2.0 ;  // get output gain value
+    params.update(*this);
+    float drive = 1+ params.get(PARAMETER_A) * 30 ; // get input drive value
+    float gain = params.get(PARAMETER_C) / 2.0 ;  // get output gain value
+    int shape = lround(params.get(PARAMETER_B)*3); // shape, once per block
     
     int size = buffer.getSize();
     for(int ch=0; ch<buffer.getChannels(); ++ch){
       float* x = buffer.getSamples(ch);
       for(int i=0; i<size; i++)
-	x[i] = gain*clip(nonLinear((x[i])*drive)); // process each sample
+	x[i] = gain*clip(nonLinear((x[i])*drive, shape)); // process each sample
     }
   }    
     
-  float nonLinear(float x){ 		// Waveshaper curve
-    float y;
-    int s = lround(getParameterValue(PARAMETER_B)*3); // shape      
+  float nonLinear(float x, int s){ 		// Waveshaper curve
+    float y = x;
     switch (s) {
     case 0:
       y = 2*x*x - 1; // Chebyshef order 2
@@ -2,7 +2,7 @@
 #ifndef WAVESHAPER_table
  #define WAVESHAPER_table
  #define WAVESHAPER_N 65536
-static float WAVESHAPER[65536]={
+static const float WAVESHAPER[65536]={
 -0.999000,
 -0.999000,
 -0.999000,
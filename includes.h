@@ -25,17 +25,28 @@
 #include "FeedbackCombFilterPatch.hpp"
 #include "SynthPatch.hpp"
 #include "FourBandsEqPatch.hpp"
+#include "HarpStringsPatch.hpp"
+#include "KisanaPatch.hpp"
 #include "Contest/blo_bleep.hpp"
 #include "Contest/BiasPatch.hpp"
 #include "Contest/BitH8rPatch.hpp"
 #include "Contest/ConnyPatch.hpp"
 #include "Contest/DroneBox.hpp"
 #include "Contest/DualTremoloPatch.hpp"
+#include "Contest/SampleJitterPatch.hpp"
 #include "mdaPorts/MdaBandistoPatch.cpp"
 #include "mdaPorts/MdaStereoPatch.cpp"
 #include "mdaPorts/MdaTransientPatch.cpp"
 #include "Qompression.hpp"
+#include "QuadratureCompanderPatch.hpp"
+#include "CrybabyWahPatch.hpp"
+#include "StereoCrybabyWahPatch.hpp"
+#include "AutoCrybabyWahPatch.hpp"
+#include "LowPassBiquadPatch.hpp"
+#include "LowShelfBiquadPatch.hpp"
+#include "PingPongEchoPatch.hpp"
 #include "PsycheFilter.hpp"
+#include "JotReverbPatch.hpp"
 */
 #include "ChorusPatch.hpp"
 /*#include "Tremolo.hpp"
@@ -43,16 +54,13 @@
 #include "SimpleDistortionPatch.hpp"
 #include "MoogPatch.hpp"
 
-#include "FeedbackCombFilter.hpp"
 */
-// #include "JotReverbPatch.hpp" // bug fix to be done re. new firmware
 // #include "SimpleDriveDelayPatch.hpp"
 // #include "Autotalent/AutotalentPatch.hpp"
 // #include "TemplatePatch.hpp"
 // #include "EnvelopeFilterPatch.hpp" /* too cpu intensive (sqrt...) */
 // #include "TemplatePatch.hpp"
 // #include "Contest/JumpDelay.hpp" /* uses calloc and free */
-// #include "Contest/SampleJitterPatch.hpp" /* requires juce::Random */
 // #include "Contest/SirenPatch.hpp" /* causes assert_failed in DMA_GetFlagStatus() */
 // #include "LpfDelayPatch.hpp" /* not compatible with Windows yet */
 // #include "LpfDelayPhaserPatch.hpp" /* not compatible with Windows yet */
@@ -39,30 +39,38 @@ REGISTER_PATCH(RingModulatorPatch, "Ring Modulator", 2, 2);
 REGISTER_PATCH(FeedbackCombFilterPatch, "Feedback Comb Filter", 2, 2);
 REGISTER_PATCH(SynthPatch, "Synthesizer", 1, 1);
 REGISTER_PATCH(FourBandsEqPatch, "FourBandsEqPatch", 1, 1);
+REGISTER_PATCH(HarpStringsPatch, "Harp Strings", 0, 2);
+REGISTER_PATCH(KisanaPatch, "Kisana", 1, 1);
 REGISTER_PATCH(BiasedDelayPatch, "Contest/BiasedDelayPatch", 2, 2);
 REGISTER_PATCH(little_blo_bleep, "Contest/blo bleep", 2, 2);
 REGISTER_PATCH(BiasPatch, "Contest/Bias", 2, 2);
 REGISTER_PATCH(BitH8rPatch, "Contest/BitH8r", 2, 2);
 REGISTER_PATCH(ConnyPatch, "Contest/ConnyPatch", 2, 2);
 REGISTER_PATCH(DualTremoloPatch, "Contest/DualTremolo", 2, 2);
+REGISTER_PATCH(SampleJitterPatch, "Contest/SampleJitter", 2, 2);
 REGISTER_PATCH(MdaBandistoPatch, "mdaPorts/MdaBandisto", 2, 2);
 REGISTER_PATCH(MdaStereoPatch, "mdaPorts/MdaStereo", 2, 2);
 REGISTER_PATCH(MdaTransientPatch, "mdaPorts/MdaTransient", 2, 2);
 REGISTER_PATCH(QompressionPatch, "Qompression", 2, 2);
+REGISTER_PATCH(QuadratureCompanderPatch, "Quadrature Compander", 1, 1);
+REGISTER_PATCH(CrybabyWahPatch, "Crybaby Wah", 1, 1);
+REGISTER_PATCH(StereoCrybabyWahPatch, "Stereo Crybaby Wah", 2, 2);
+REGISTER_PATCH(AutoCrybabyWahPatch, "Auto Crybaby Wah", 1, 1);
+REGISTER_PATCH(LowPassBiquadPatch, "Low Pass Filter", 1, 1);
+REGISTER_PATCH(LowShelfBiquadPatch, "Low Shelf", 1, 1);
+REGISTER_PATCH(PingPongEchoPatch, "Ping Pong Echo", 2, 2);
 REGISTER_PATCH(PsycheFilterPatch, "Psyche Filter", 2, 2);
 REGISTER_PATCH(ReverseReverbPatch, "ReverseReverbPatch", 1, 1);
 REGISTER_PATCH(SimpleDistortionPatch, "SimpleDistortionPatch", 1, 1);
 REGISTER_PATCH(MoogPatch, "MoogPatch", 1, 1);
-REGISTER_PATCH(FeedbackCombFilter, "FeedbackCombFilter", 1, 1);
+REGISTER_PATCH(JotReverbPatch, "JotReverbPatch", 2, 2);
 TO BE WORKED ON
 */
-// REGISTER_PATCH(JotReverbPatch,"JotReverbPatch", 2, 2);
 // REGISTER_PATCH(SimpleDriveDelayPatch, "Drive Delay", 1, 1);
 // REGISTER_PATCH(AutotalentPatch, "AutoTalent", 2, 2);
 // REGISTER_PATCH(EnvelopeFilterPatch, "Envelope Filter", 1, 1);
 // REGISTER_PATCH(TemplatePatch, "Template", 0, 0);
 // REGISTER_PATCH(JumpDelay, "Contest/JumpDelay", 0, 0);
-// REGISTER_PATCH(SampleJitterPatch, "Contest/SampleJitterPatch", 0, 0);
 // REGISTER_PATCH(SirenPatch, "Contest/SirenPatch", 0, 0);
 // REGISTER_PATCH(LpfDelayPatch, "Low Pass Filtered Delay", 1, 1);
 // REGISTER_PATCH(LpfDelayPhaserPatch, "Low Pass Filtered Delay with Phaser", 1, 1);